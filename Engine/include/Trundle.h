@@ -26,6 +26,10 @@
 #include <Trundle/Core/log.h>
 #include <Trundle/Core/pointer.h>
 #include <Trundle/Events/event.h>
+#include <Trundle/Events/eventData.h>
+#include <Trundle/Events/eventLog.h>
 #include <Trundle/Events/keyEvent.h>
 #include <Trundle/Events/mouseEvent.h>
+#include <Trundle/Events/timerEvent.h>
+#include <Trundle/Events/userEvent.h>
 #include <Trundle/Events/windowEvent.h>
\ No newline at end of file
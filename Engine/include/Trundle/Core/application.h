@@ -22,15 +22,29 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <Trundle/Core/clock.h>
+#include <Trundle/Core/frameLimiter.h>
+#include <Trundle/Core/gamepad.h>
 #include <Trundle/Core/input.h>
+#include <Trundle/Core/inputActions.h>
+#include <Trundle/Core/inputHistory.h>
 #include <Trundle/Core/keyCode.h>
+#include <Trundle/Core/latencyHistogram.h>
 #include <Trundle/Core/layerStack.h>
+#include <Trundle/Core/mpscQueue.h>
 #include <Trundle/Core/pointer.h>
+#include <Trundle/Core/timerWheel.h>
+#include <Trundle/Core/timestep.h>
 #include <Trundle/Core/util.h>
 #include <Trundle/Core/window.h>
+#include <Trundle/Core/workerPool.h>
 #include <Trundle/Events/event.h>
+#include <Trundle/Events/eventData.h>
+#include <Trundle/Events/eventLog.h>
+#include <Trundle/Events/eventQueue.h>
 #include <Trundle/Events/keyEvent.h>
 #include <Trundle/Events/mouseEvent.h>
+#include <Trundle/Events/timerEvent.h>
 #include <Trundle/Events/windowEvent.h>
 #include <Trundle/common.h>
 
@@ -57,7 +71,10 @@ public:
   ///
   /// Defines the game loop for the Engine. The game loop is a loop that is
   /// run on each tick or frame of the game and consits of a logic calcualtion
-  /// phase and a rendering phase.
+  /// phase and a rendering phase. The loop is paced by the frame rate limit
+  /// if one is set, otherwise a headless application with a fixed timestep
+  /// sleeps until its next update is due. See @ref setIdleMode for waiting
+  /// on events.
   void run();
 
   /// @brief Used for testing the main game loop of the Engine.
@@ -78,7 +95,38 @@ public:
   /// @param[in,out] events The list of events to run in the game loop. As a
   ///                       side effect each event that was handled can be
   ///                       checked with the handled flag in @ref Event .
-  void run(std::vector<Ref<Event>> events);
+  void run(const std::vector<Ref<Event>>& events);
+
+  /// @brief Starts recording every handled event to an event log.
+  ///
+  /// Window events, posted events, timer events and the events passed to
+  /// @ref run are recorded as they are handled, along with the time since the
+  /// recording started and the frame they were handled in, see
+  /// @ref EventLog. Each update of the layers is recorded with its step.
+  /// Gamepads are polled rather than sent as events and are not recorded.
+  /// @param[in] path The path of the log to write.
+  /// @return true if the log was created and false otherwise.
+  bool startRecording(const std::string& path);
+
+  /// @brief Stops recording and closes the event log.
+  void stopRecording();
+
+  /// @brief Replays an event log as fast as possible.
+  ///
+  /// The events are read straight out of the memory mapped log and handled in
+  /// order. Every update of the layers is recorded with its step, so the
+  /// layers are updated at the same points and with the same steps as they
+  /// were while recording, with or without a fixed timestep. If the
+  /// recording stopped before the last events were followed by an update,
+  /// one more update is run with the last recorded step. The timer and
+  /// posted events come from the log, so timers are not processed and posted
+  /// events are not handled while replaying, and the gamepads read as
+  /// disconnected. Replay does not wait on the recorded timestamps, present
+  /// the window or render the layers, and logs of older versions are
+  /// rejected.
+  /// @param[in] path The path of the log to replay.
+  /// @return The number of events that were replayed.
+  size_t replay(const std::string& path);
 
   /// @brief Callback function that handles the @ref KeyPressEvent.
   ///
@@ -120,21 +168,237 @@ public:
   /// @return true if the event was handled and false otherwise.
   bool onMouseMove(MouseMoveEvent& event);
 
+  /// @brief Callback function that handles the @ref MouseScrollEvent.
+  ///
+  /// Whenever a @ref MouseScrollEvent is encountered this function is called
+  /// to attempt to handle it.
+  /// @param[in,out] event The event to handle.
+  /// @return true if the event was handled and false otherwise.
+  bool onMouseScroll(MouseScrollEvent& event);
+
   /// @brief Default event callback.
   ///
   /// Default event handler that dispatches the events to appropriot functions.
   /// @param[in,out] event The event to handle.
   void onEvent(Event &event);
 
+  /// @brief Handles an event from the main loop.
+  ///
+  /// Records the event if a recording has been started, then handles it with
+  /// @ref onEvent. Every event that the main loop hands to the layers goes
+  /// through here, so that a replay sees the same events.
+  /// @param[in,out] event The event to handle.
+  void dispatchEvent(Event& event);
+
+  /// @brief Handles every event in a queue and then clears it.
+  ///
+  /// Used once per frame to handle all of the input that was gathered by the
+  /// window in a single batch, before any layers are updated.
+  /// @param[in,out] queue The events to handle.
+  void processEvents(EventQueue& queue);
+
+  /// @brief Gets the number of events that were handled in the last batch.
+  ///
+  /// @return The depth of the event queue on the last call to
+  ///         @ref processEvents.
+  inline size_t getEventQueueDepth() const { return eventQueueDepth; }
+
+  /// @brief Gets the time taken to handle each window event in the last
+  ///        frame.
+  ///
+  /// @return A histogram of the time from each event arriving to the engine
+  ///         and layers finishing with it.
+  inline const LatencyHistogram& getHandlingLatency() const {
+    return handlingLatency;
+  }
+
+  /// @brief Gets the input latency of each window event in the last frame.
+  ///
+  /// @return A histogram of the time from each event arriving to the frame
+  ///         that reflects it being presented.
+  inline const LatencyHistogram& getPresentLatency() const {
+    return presentLatency;
+  }
+
+  /// @brief Gets the input state of the most recent frames.
+  ///
+  /// A record is added at the start of every frame, before the layers are
+  /// updated, and the last 64 frames are kept.
+  /// @return The input history.
+  inline const InputHistory& getInputHistory() const { return inputHistory; }
+
+  /// @brief Gets the actions of the application.
+  ///
+  /// The actions are resolved at the start of every frame, before the layers
+  /// are updated, so layers can query them by index from onUpdate.
+  /// @return The actions and their bindings.
+  inline InputActions& getInputActions() { return inputActions; }
+
+  /// @brief Enables or disables coalescing of the window events.
+  ///
+  /// When enabled, back to back mouse moves, scrolls and window resizes
+  /// received in a frame are merged into a single event, see
+  /// @ref EventQueue. This is disabled by default.
+  /// @param[in] enable True to enable coalescing, false to disable it.
+  void setEventCoalescing(bool enable);
+
+  /// @brief Enables or disables raw mouse motion for the window.
+  ///
+  /// While enabled the cursor is hidden and captured by the window, and mouse
+  /// moves report unaccelerated motion where the platform supports it, which
+  /// suits mouse-look. Use @ref Input::getMouseDelta rather than the position.
+  /// @param[in] enable True to enable raw mouse motion, false to disable it.
+  /// @return true if the mode was changed and false if it is not supported.
+  bool setRawMouseMotion(bool enable);
+
+  /// @brief Enables or disables checking the key state with the OS.
+  ///
+  /// When enabled, the keys that the engine believes are held are checked
+  /// with the window at the end of every frame, and a @ref KeyReleaseEvent
+  /// is queued for any that the OS reports as released. This recovers from
+  /// releases that were never delivered, such as when the window loses focus
+  /// while a key is held. Keys pressed by events that did not come from the
+  /// window are also released, so this is disabled by default.
+  /// @param[in] enable True to enable reconciliation, false to disable it.
+  inline void setKeyReconciliation(bool enable) { reconcileKeys = enable; }
+
+  /// @brief Sets the frame rate limit of @ref run.
+  ///
+  /// Useful with v-sync disabled, or when headless, where the loop would
+  /// otherwise run as fast as it can. See @ref FrameLimiter.
+  /// @param[in] hertz The maximum number of frames per second, 0 for no
+  ///                  limit, which is the default.
+  void setFrameRateLimit(uint32_t hertz);
+
+  /// @brief Gets the frame rate limit of @ref run.
+  ///
+  /// @return The maximum number of frames per second, 0 for no limit.
+  inline uint32_t getFrameRateLimit() const { return frameLimiter.getRate(); }
+
+  /// @brief Enables or disables waiting for events when there is nothing to
+  ///        draw.
+  ///
+  /// When enabled, each frame of @ref run waits for a window event, a posted
+  /// event or the next timer before it starts, unless @ref requestFrame was
+  /// called since the last frame began. This lets editors and tools use
+  /// almost no CPU while nothing is happening. Layers that animate should
+  /// request a frame every frame. Gamepads are only polled when a frame runs.
+  /// Has no effect when headless. This is disabled by default.
+  /// @param[in] enable True to enable idling, false to disable it.
+  inline void setIdleMode(bool enable) { idle = enable; }
+
+  /// @brief Checks if the application idles when there is nothing to draw.
+  inline bool isIdleMode() const { return idle; }
+
+  /// @brief Asks for another frame to run without waiting for an event.
+  ///
+  /// Only has an effect in idle mode. May be called from any thread, and
+  /// wakes the main loop if it is waiting.
+  void requestFrame();
+
+  /// @brief Sets the number of threads that update the layers.
+  ///
+  /// Layers in the same update level (see @ref LayerStack::getUpdateLevels)
+  /// are updated at the same time across the threads, and each level waits
+  /// for the one before it. Layers only share a level if they have declared
+  /// dependencies that do not conflict, so a stack of layers that declare
+  /// nothing is still updated one at a time. Events are always handled on
+  /// the main thread in stack order. This is 1 by default, and must not be
+  /// changed while the layers are being updated.
+  /// @param[in] threads The number of threads, including the main thread. 0
+  ///                    uses one thread per core.
+  void setUpdateThreads(size_t threads);
+
+  /// @brief Gets the number of threads that update the layers.
+  ///
+  /// @return The number of threads, including the main thread.
+  size_t getUpdateThreads() const;
+
+  /// @brief Posts an event to be handled by the main loop.
+  ///
+  /// This function is lock-free and may be called from any thread, the event
+  /// is handled on the main thread along with the window events of the next
+  /// frame. If the main loop is idle it is woken to handle the event.
+  /// @param[in] event The event to post.
+  /// @return true if the event was queued and false if the queue was full.
+  bool postEvent(const EventData& event);
+
+  /// @brief Handles every event that has been posted with @ref postEvent.
+  ///
+  /// Must only be called from the thread running the main loop.
+  void processPostedEvents();
+
+  /// @brief Schedules a @ref TimerEvent to be sent after a delay.
+  ///
+  /// Timers are checked once per frame, after the window and posted events,
+  /// and fire in the first frame at or after their deadline with a resolution
+  /// of one millisecond.
+  /// @param[in] delay The number of nanoseconds to wait.
+  /// @param[in] code An application defined code sent with the event.
+  /// @param[in] period If not 0, the timer fires again every period
+  ///                   nanoseconds until it is cancelled.
+  /// @return A handle that can be used to cancel the timer.
+  TimerHandle scheduleTimer(Timestamp delay, uint32_t code,
+                            Timestamp period = 0);
+
+  /// @brief Cancels a timer scheduled with @ref scheduleTimer.
+  ///
+  /// @param[in] handle The timer to cancel.
+  /// @return true if the timer was pending and false otherwise.
+  bool cancelTimer(TimerHandle handle);
+
+  /// @brief Sends a @ref TimerEvent for every timer that is due.
+  void processTimers();
+
+  /// @brief Replaces the clock that drives the timers.
+  ///
+  /// Any pending timers are cancelled, since their deadlines were measured on
+  /// the old clock.
+  /// @param[in] newClock The clock to use.
+  void setClock(Ref<Clock> newClock);
+
+  /// @brief Gets the clock that drives the timers.
+  inline const Ref<Clock>& getClock() const { return clock; }
+
+  /// @brief Sets the rate of the fixed timestep.
+  ///
+  /// With a fixed timestep the time between frames is added to an
+  /// accumulator, and the layers are updated once for every whole step in it,
+  /// so the simulation advances by the same amount whatever the frame rate.
+  /// The time left over is passed to @ref Layer::onRender as a fraction of a
+  /// step, to interpolate between the last two updates. At most 250ms is
+  /// added per frame, so a long stall does not cause a burst of updates. The
+  /// time is read from the application's clock, see @ref setClock.
+  ///
+  /// Without a fixed timestep, the default, the layers are updated once per
+  /// frame with the time since the last frame.
+  /// @param[in] hertz The number of updates per second, or 0 to update once
+  ///                  per frame.
+  void setFixedTimestep(uint32_t hertz);
+
+  /// @brief Gets the fixed timestep.
+  ///
+  /// @return The step between updates, 0 if there is no fixed timestep.
+  inline Timestep getFixedTimestep() const { return fixedStep; }
+
+  /// @brief Gets how far the last frame was between two fixed updates.
+  ///
+  /// @return The value passed to @ref Layer::onRender in the last frame.
+  inline float getInterpolationAlpha() const { return alpha; }
+
   /// @brief Adds a new @ref Layer to the application.
   ///
+  /// Layers may be pushed and popped from their own onUpdate and onEvent, in
+  /// which case the change takes effect at the end of the frame.
   /// @param[in] layer The layer to add.
-  void pushLayer(Ref<Layer> layer);
+  /// @return A handle to the layer.
+  LayerHandle pushLayer(Ref<Layer> layer);
 
   /// @brief Adds a new @ref Layer to the application as an overlay layer.
   ///
   /// @param[in] layer The overlay layer to add.
-  void pushOverlay(Ref<Layer> overlay);
+  /// @return A handle to the layer.
+  LayerHandle pushOverlay(Ref<Layer> overlay);
 
   /// @brief Removes a @ref Layer from the application.
   ///
@@ -146,19 +410,42 @@ public:
   /// @param[in] layer The overlay layer to remove.
   void popOverlay(Ref<Layer> overlay);
 
-  /// @brief A getter for the singleton instance of the @ref Application.
+  /// @brief Removes a @ref Layer from the application by its handle.
   ///
-  /// As @ref Application defines how the program is run, it is implemented as
-  /// a singleton and @ref get returns a pointer to the singleton instance.
-  /// @return A pointer to the singleton instance of the @ref Application.
-  inline static Application* get() { return instance; }
+  /// @param[in] layer The handle of the layer to remove.
+  void popLayer(LayerHandle layer);
+
+  /// @brief A getter for the current instance of the @ref Application.
+  ///
+  /// Each thread has its own current application, so several independent
+  /// applications can run on different threads of one process. An
+  /// application is made current on the thread that constructs it and on
+  /// every thread that runs it, and stops being current on all of them when
+  /// it is destroyed. A thread that has no current application,
+  /// such as a loader or simulation thread, gets the primary application
+  /// instead, which is the first one constructed in the process. Code that
+  /// must reach a specific application from another thread, for example when
+  /// several applications share a process, should capture that application
+  /// (or `app.getInput()`) rather than call this.
+  /// @return A pointer to the current @ref Application of the calling thread,
+  ///         else the primary application, else nullptr.
+  static Application* get();
+
+  /// @brief Makes this application and its input current on the calling
+  ///        thread.
+  ///
+  /// See @ref get and @ref Input::getContext.
+  void makeCurrent();
+
+  /// @brief Gets the input state of this application.
+  ///
+  /// @return The input context that the application's events are applied to.
+  inline InputContext& getInput() { return input; }
 
   // Returns a pointer to the window.
   inline Ref<Window> getWindow() { return window; }
 
 protected:
-  // The singleton instance of the application.
-  static Application* instance;
   // A handle to the window object.
   Ref<Window> window;
   // A stack of layers in the application.
@@ -167,6 +454,76 @@ protected:
   bool running{true};
   // A flag that indicates whether or not the application should run headlessly
   bool headless{false};
+  // The number of events that were handled in the last batch.
+  size_t eventQueueDepth{0};
+  // Events posted from other threads that are waiting to be handled.
+  MPSCQueue<EventData> postedEvents{4096};
+  // The number of frames that have been run.
+  uint64_t frame{0};
+  // Records the handled events when a recording has been started.
+  EventRecorder recorder;
+  // The source of time for the timers.
+  Ref<Clock> clock;
+  // The pending timers.
+  TimerWheel timers;
+  // The time that the last frame was updated at.
+  Timestamp lastFrameTime;
+  // The step of the fixed timestep, 0 when updating once per frame.
+  Timestep fixedStep;
+  // The time that has passed but not yet been simulated by a fixed step.
+  Timestamp accumulator{0};
+  // How far the current frame is between the last two fixed updates.
+  float alpha{1.0f};
+  // The keyboard, mouse and gamepad state of the application.
+  InputContext input;
+  // The input state of the most recent frames.
+  InputHistory inputHistory{64};
+  // The logical actions bound to the input.
+  InputActions inputActions;
+  // A flag for checking the key state with the OS at the end of each frame.
+  bool reconcileKeys{false};
+  // The threads that help update the layers, null when they are updated on
+  // the main thread only.
+  Own<WorkerPool> updatePool;
+  // Paces the main loop.
+  FrameLimiter frameLimiter;
+  // A flag for waiting on events when no frame has been requested.
+  bool idle{false};
+  // Set when a frame has been requested since the last frame began.
+  std::atomic<bool> frameRequested{false};
+  // Set while the main loop is waiting on the window for events.
+  std::atomic<bool> waiting{false};
+  // The timers that fired in the current frame.
+  std::vector<TimerWheel::Expired> expiredTimers;
+
+  // The arrival and handled times of each window event in the current frame.
+  std::vector<std::pair<Timestamp, Timestamp>> frameLatencies;
+  // The handling latency of the last frame.
+  LatencyHistogram handlingLatency;
+  // The input to present latency of the last frame.
+  LatencyHistogram presentLatency;
+
+  // Polls the window for events, or waits for them when idle.
+  void pollWindow();
+
+  // Waits until the next frame should start.
+  void waitForNextFrame();
+
+  // Runs the updates that are due and renders the layers.
+  void updateFrame();
+
+  // Updates every layer once, moving the simulation forward by a step.
+  void updateLayers(Timestep step = Timestep());
+
+  // Lets every layer render the current frame.
+  void renderLayers();
+
+  // Presents the frame and records the latency of its events.
+  void present();
+
+  // Queues a release for each key that the engine thinks is held but the
+  // window does not.
+  void reconcileKeyState();
 
   // Default handler for the window close event, which simply stops the main
   // game loop.
@@ -0,0 +1,155 @@
+//===-- bitSet.h ----------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A fixed size set of bits stored in 64 bit words, so that whole sets can be
+/// combined and compared a word at a time.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/bits.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+//===-- BitSet ------------------------------------------------------------===//
+/// @brief A fixed size set of bits.
+///
+/// Unlike std::bitset the words are exposed and the layout is fixed, so sets
+/// can be copied, hashed and serialized as plain memory and the bitwise
+/// operators compile down to a handful of 64 bit operations.
+//===----------------------------------------------------------------------===//
+template <size_t Bits>
+class BitSet {
+public:
+  /// @brief The number of 64 bit words used to store the bits.
+  static constexpr size_t WordCount = (Bits + 63) / 64;
+
+  /// @brief Sets a bit.
+  constexpr void set(size_t bit) {
+    words[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+
+  /// @brief Clears a bit.
+  constexpr void reset(size_t bit) {
+    words[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+  }
+
+  /// @brief Clears every bit.
+  constexpr void reset() {
+    for (auto& word : words) {
+      word = 0;
+    }
+  }
+
+  /// @brief Checks if a bit is set.
+  constexpr bool test(size_t bit) const {
+    return (words[bit / 64] >> (bit % 64)) & 1;
+  }
+
+  /// @brief Checks if any bit is set.
+  constexpr bool any() const {
+    uint64_t combined = 0;
+    for (auto word : words) {
+      combined |= word;
+    }
+    return combined != 0;
+  }
+
+  /// @brief Checks if no bit is set.
+  constexpr bool none() const { return !any(); }
+
+  /// @brief Calls a function with the index of every set bit, in ascending
+  ///        order.
+  ///
+  /// Only set bits are visited, each word is skipped with a single compare
+  /// when it is empty and otherwise scanned with count trailing zeros.
+  /// @param[in] func A callable that accepts a size_t.
+  template <typename Func>
+  void forEachSet(Func&& func) const {
+    for (size_t i = 0; i < WordCount; ++i) {
+      uint64_t word = words[i];
+      while (word != 0) {
+        func(i * 64 + countTrailingZeros(word));
+        // Clear the lowest set bit.
+        word &= word - 1;
+      }
+    }
+  }
+
+  /// @brief Gets the words that store the bits, bit i is bit i % 64 of word
+  ///        i / 64.
+  constexpr const std::array<uint64_t, WordCount>& getWords() const {
+    return words;
+  }
+
+  /// @brief Gets the words that store the bits for writing.
+  constexpr std::array<uint64_t, WordCount>& getWords() { return words; }
+
+  constexpr BitSet operator&(const BitSet& other) const {
+    BitSet result;
+    for (size_t i = 0; i < WordCount; ++i) {
+      result.words[i] = words[i] & other.words[i];
+    }
+    return result;
+  }
+
+  constexpr BitSet operator|(const BitSet& other) const {
+    BitSet result;
+    for (size_t i = 0; i < WordCount; ++i) {
+      result.words[i] = words[i] | other.words[i];
+    }
+    return result;
+  }
+
+  constexpr BitSet operator^(const BitSet& other) const {
+    BitSet result;
+    for (size_t i = 0; i < WordCount; ++i) {
+      result.words[i] = words[i] ^ other.words[i];
+    }
+    return result;
+  }
+
+  /// @brief Flips every bit, including the unused bits of the last word.
+  constexpr BitSet operator~() const {
+    BitSet result;
+    for (size_t i = 0; i < WordCount; ++i) {
+      result.words[i] = ~words[i];
+    }
+    return result;
+  }
+
+  constexpr bool operator==(const BitSet& other) const {
+    for (size_t i = 0; i < WordCount; ++i) {
+      if (words[i] != other.words[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  constexpr bool operator!=(const BitSet& other) const {
+    return !(*this == other);
+  }
+
+private:
+  // Storage for the bits.
+  std::array<uint64_t, WordCount> words{};
+};
+
+} // namespace Trundle
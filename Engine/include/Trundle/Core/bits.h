@@ -0,0 +1,61 @@
+//===-- bits.h ------------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// Helpers for scanning the bits of a word, which compile down to a single
+/// instruction on every supported compiler.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/common.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Trundle {
+
+/// @brief Counts the zero bits below the lowest set bit.
+///
+/// @param[in] word The word to scan, must not be 0.
+/// @return The index of the lowest set bit.
+inline size_t countTrailingZeros(uint64_t word) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward64(&index, word);
+  return static_cast<size_t>(index);
+#else
+  return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+}
+
+/// @brief Counts the zero bits above the highest set bit.
+///
+/// @param[in] word The word to scan, must not be 0.
+/// @return 63 minus the index of the highest set bit.
+inline size_t countLeadingZeros(uint64_t word) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanReverse64(&index, word);
+  return 63 - static_cast<size_t>(index);
+#else
+  return static_cast<size_t>(__builtin_clzll(word));
+#endif
+}
+
+} // namespace Trundle
@@ -0,0 +1,87 @@
+//===-- clock.h -----------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// The monotonic, high resolution time source used to stamp events and measure
+/// latency in the engine, and the clocks that can be injected into the engine
+/// so that time driven code can be tested deterministically.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+/// @brief A point in time in nanoseconds, measured on a monotonic clock with an
+///        unspecified epoch. Only the difference between two timestamps is
+///        meaningful.
+using Timestamp = uint64_t;
+
+/// @brief Reads the monotonic clock.
+///
+/// @return The current time.
+inline Timestamp getTimestamp() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return static_cast<Timestamp>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+//===-- Clock -------------------------------------------------------------===//
+/// @brief An interface for a source of time.
+//===----------------------------------------------------------------------===//
+class Clock {
+public:
+  virtual ~Clock() = default;
+
+  /// @brief Reads the clock.
+  ///
+  /// @return The current time, must never go backwards.
+  virtual Timestamp now() const = 0;
+};
+
+//===-- SystemClock -------------------------------------------------------===//
+/// @brief A clock that reads the monotonic system clock.
+//===----------------------------------------------------------------------===//
+class SystemClock : public Clock {
+public:
+  Timestamp now() const override { return getTimestamp(); }
+};
+
+//===-- ManualClock -------------------------------------------------------===//
+/// @brief A clock that only moves when it is told to, used for testing.
+//===----------------------------------------------------------------------===//
+class ManualClock : public Clock {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] start The time that the clock starts at.
+  explicit ManualClock(Timestamp start = 0) : time(start) {}
+
+  Timestamp now() const override { return time; }
+
+  /// @brief Moves the clock forward.
+  ///
+  /// @param[in] duration The number of nanoseconds to move forward by.
+  void advance(Timestamp duration) { time += duration; }
+
+private:
+  // The current time.
+  Timestamp time;
+};
+
+} // namespace Trundle
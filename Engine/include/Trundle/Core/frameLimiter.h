@@ -0,0 +1,86 @@
+//===-- frameLimiter.h ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// Paces the main loop to a target frame rate.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/clock.h>
+#include <Trundle/Core/util.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+//===-- FrameLimiter ------------------------------------------------------===//
+/// @brief Caps the frame rate of a loop by waiting at the end of each frame.
+///
+/// The OS only wakes a sleeping thread to within a scheduler tick, so the
+/// limiter sleeps until shortly before the deadline and then spins for the
+/// rest. This keeps frame times accurate while leaving the core idle for
+/// most of the wait. Deadlines are spaced exactly one period apart, so short
+/// oversleeps do not add up, but a frame that runs a whole period late
+/// starts a new schedule rather than letting the next frames catch up.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API FrameLimiter {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] hertz The maximum number of frames per second, 0 for no
+  ///                  limit.
+  explicit FrameLimiter(uint32_t hertz = 0);
+
+  /// @brief Sets the frame rate limit.
+  ///
+  /// @param[in] hertz The maximum number of frames per second, 0 for no
+  ///                  limit.
+  void setRate(uint32_t hertz);
+
+  /// @brief Gets the frame rate limit.
+  ///
+  /// @return The maximum number of frames per second, 0 for no limit.
+  inline uint32_t getRate() const { return rate; }
+
+  /// @brief Sets how long before the deadline to stop sleeping and spin.
+  ///
+  /// Should be at least the sleep accuracy of the OS, larger values are more
+  /// accurate but use more CPU. This is 1ms by default.
+  /// @param[in] threshold The length of the spin in nanoseconds.
+  void setSpinThreshold(Timestamp threshold);
+
+  /// @brief Waits until the next frame is due.
+  ///
+  /// Returns straight away if there is no limit, on the first call, and
+  /// when the frame is running late.
+  void wait();
+
+  /// @brief Forgets the schedule, so the next @ref wait starts a new one.
+  void reset();
+
+private:
+  // The maximum number of frames per second.
+  uint32_t rate{0};
+  // The time between frames.
+  Timestamp period{0};
+  // The time before the deadline that sleeping stops.
+  Timestamp spinThreshold{1000000};
+  // The time that the next frame is due, 0 before the first frame.
+  Timestamp deadline{0};
+};
+
+} // namespace Trundle
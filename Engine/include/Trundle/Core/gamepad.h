@@ -0,0 +1,278 @@
+//===-- gamepad.h ---------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// Polls the connected gamepads once per frame and tracks their buttons and
+/// axes.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/pointer.h>
+#include <Trundle/Core/util.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+/// @brief The maximum number of gamepads that can be connected at once.
+constexpr size_t GamepadCount = 16;
+
+//===-- GamepadButton -----------------------------------------------------===//
+/// @brief The buttons of a gamepad, laid out like an Xbox controller.
+//===----------------------------------------------------------------------===//
+enum class GamepadButton {
+  A = 0,
+  B,
+  X,
+  Y,
+  LeftBumper,
+  RightBumper,
+  Back,
+  Start,
+  Guide,
+  LeftThumb,
+  RightThumb,
+  DpadUp,
+  DpadRight,
+  DpadDown,
+  DpadLeft
+};
+
+/// @brief The number of values in @ref GamepadButton.
+constexpr size_t GamepadButtonCount =
+    static_cast<size_t>(GamepadButton::DpadLeft) + 1;
+
+//===-- GamepadAxis -------------------------------------------------------===//
+/// @brief The axes of a gamepad.
+///
+/// The sticks range from -1 to 1 and rest at 0, the triggers range from -1
+/// when released to 1 when fully pressed.
+//===----------------------------------------------------------------------===//
+enum class GamepadAxis {
+  LeftX = 0,
+  LeftY,
+  RightX,
+  RightY,
+  LeftTrigger,
+  RightTrigger
+};
+
+/// @brief The number of values in @ref GamepadAxis.
+constexpr size_t GamepadAxisCount =
+    static_cast<size_t>(GamepadAxis::RightTrigger) + 1;
+
+/// @brief The state of a single gamepad as read from a device.
+struct GamepadState {
+  /// @brief A bit for each @ref GamepadButton that is pressed.
+  uint32_t buttons{0};
+  /// @brief The position of each @ref GamepadAxis.
+  std::array<float, GamepadAxisCount> axes{0, 0, 0, 0, -1, -1};
+};
+
+//===-- GamepadSource -----------------------------------------------------===//
+/// @brief An interface for the devices that gamepads are read from.
+///
+/// This abstraction needs to have an inherited implementation for each OS
+/// supported by Trundle, tests can provide their own with
+/// @ref ManualGamepadSource.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API GamepadSource {
+public:
+  virtual ~GamepadSource() = default;
+
+  /// @brief Reads the state of a gamepad.
+  ///
+  /// @param[in] id The gamepad to read, less than @ref GamepadCount.
+  /// @param[out] state Set to the state of the gamepad if it is connected.
+  /// @return true if the gamepad is connected and false otherwise.
+  virtual bool read(size_t id, GamepadState& state) = 0;
+
+  /// @brief Creates the source for the gamepads of the OS.
+  ///
+  /// @return A pointer to the new source.
+  static GamepadSource* create();
+};
+
+//===-- ManualGamepadSource -----------------------------------------------===//
+/// @brief A source whose gamepads are only changed when it is told to, used
+///        for testing.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API ManualGamepadSource : public GamepadSource {
+public:
+  bool read(size_t id, GamepadState& state) override {
+    assert(id < GamepadCount && "Error: Not a gamepad.");
+    state = states[id];
+    return connected[id];
+  }
+
+  /// @brief Connects or disconnects a gamepad.
+  void setConnected(size_t id, bool isConnected) {
+    assert(id < GamepadCount && "Error: Not a gamepad.");
+    connected[id] = isConnected;
+    if (!isConnected) {
+      states[id] = GamepadState();
+    }
+  }
+
+  /// @brief Presses or releases a button of a gamepad.
+  void setButton(size_t id, GamepadButton button, bool pressed) {
+    assert(id < GamepadCount && "Error: Not a gamepad.");
+    uint32_t bit = uint32_t(1) << static_cast<uint32_t>(button);
+    states[id].buttons = pressed ? states[id].buttons | bit
+                                 : states[id].buttons & ~bit;
+  }
+
+  /// @brief Moves an axis of a gamepad.
+  void setAxis(size_t id, GamepadAxis axis, float value) {
+    assert(id < GamepadCount && "Error: Not a gamepad.");
+    states[id].axes[static_cast<size_t>(axis)] = value;
+  }
+
+private:
+  std::array<GamepadState, GamepadCount> states{};
+  std::array<bool, GamepadCount> connected{};
+};
+
+//===-- GamepadContext ----------------------------------------------------===//
+/// @brief The state of every gamepad seen by an @ref InputContext.
+///
+/// The gamepads are read from a @ref GamepadSource once per frame by
+/// @ref poll, rather than being queried by each caller. The state is stored as
+/// a structure of arrays, one row per axis holding that axis for every
+/// gamepad, so the dead zone is applied to all gamepads in a single tight
+/// loop that the compiler can vectorize.
+///
+/// Buttons have the same edge semantics as keys in @ref Input, except that a
+/// press and release within a single frame can not be seen when polling.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API GamepadContext {
+public:
+  /// @brief Sets the device that the gamepads are read from.
+  ///
+  /// @param[in] source The source to read from, or nullptr to disconnect all
+  ///                   gamepads.
+  void setSource(Ref<GamepadSource> source);
+
+  /// @brief Gets the device that the gamepads are read from.
+  ///
+  /// @return The source, or nullptr if there is none.
+  inline const Ref<GamepadSource>& getSource() const { return source; }
+
+  /// @brief Reads every gamepad and starts a new frame of gamepad input.
+  ///
+  /// Called by the @ref Application once per frame before the layers are
+  /// updated.
+  void poll();
+
+  /// @brief Sets the dead zone of the sticks.
+  ///
+  /// Stick positions with a magnitude below the dead zone read as 0, and the
+  /// remaining range is rescaled so that the sticks still reach 1. The
+  /// triggers are not affected.
+  /// @param[in] deadZone The dead zone, must be in the range [0, 1).
+  void setDeadZone(float deadZone);
+
+  /// @brief Gets the dead zone of the sticks.
+  float getDeadZone() const;
+
+  /// @brief Checks if a gamepad is connected.
+  ///
+  /// @param[in] id The gamepad to query, less than @ref GamepadCount.
+  /// @return true if the gamepad was connected when last polled.
+  bool isConnected(size_t id) const;
+
+  /// @brief Checks if a button of a gamepad is pressed.
+  bool isButtonDown(size_t id, GamepadButton button) const;
+
+  /// @brief Checks if a button of a gamepad went down during the last frame.
+  bool wasPressedThisFrame(size_t id, GamepadButton button) const;
+
+  /// @brief Checks if a button of a gamepad went up during the last frame.
+  ///
+  /// Disconnecting a gamepad releases all of its buttons.
+  bool wasReleasedThisFrame(size_t id, GamepadButton button) const;
+
+  /// @brief Gets the position of an axis of a gamepad.
+  ///
+  /// @param[in] id The gamepad to query, less than @ref GamepadCount.
+  /// @param[in] axis The axis to query.
+  /// @return The position of the axis with the dead zone applied.
+  float getAxis(size_t id, GamepadAxis axis) const;
+
+private:
+  // Applies the dead zone to the raw stick positions.
+  void applyDeadZone();
+
+  // The device that the gamepads are read from.
+  Ref<GamepadSource> source;
+  float deadZone{0.15f};
+  // A bit for each gamepad that is connected.
+  uint32_t connected{0};
+  // The buttons of each gamepad that are down, were down last frame, and that
+  // were pressed and released in the last frame.
+  std::array<uint32_t, GamepadCount> buttonsDown{};
+  std::array<uint32_t, GamepadCount> previousButtonsDown{};
+  std::array<uint32_t, GamepadCount> buttonsPressed{};
+  std::array<uint32_t, GamepadCount> buttonsReleased{};
+  // The position of each axis of every gamepad, as read and after the dead
+  // zone is applied, indexed by [axis][gamepad].
+  using AxisRows =
+      std::array<std::array<float, GamepadCount>, GamepadAxisCount>;
+  AxisRows rawAxes{};
+  AxisRows axes{};
+};
+
+//===-- Gamepads ----------------------------------------------------------===//
+/// @brief Access to the gamepads of the current @ref InputContext.
+///
+/// Each function forwards to the @ref GamepadContext of
+/// @ref Input::getContext, see there for details.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API Gamepads {
+public:
+  /// @brief Sets the device that the gamepads are read from.
+  static void setSource(Ref<GamepadSource> source);
+
+  /// @brief Reads every gamepad and starts a new frame of gamepad input.
+  static void poll();
+
+  /// @brief Sets the dead zone of the sticks.
+  static void setDeadZone(float deadZone);
+
+  /// @brief Gets the dead zone of the sticks.
+  static float getDeadZone();
+
+  /// @brief Checks if a gamepad is connected.
+  static bool isConnected(size_t id);
+
+  /// @brief Checks if a button of a gamepad is pressed.
+  static bool isButtonDown(size_t id, GamepadButton button);
+
+  /// @brief Checks if a button of a gamepad went down during the last frame.
+  static bool wasPressedThisFrame(size_t id, GamepadButton button);
+
+  /// @brief Checks if a button of a gamepad went up during the last frame.
+  static bool wasReleasedThisFrame(size_t id, GamepadButton button);
+
+  /// @brief Gets the position of an axis of a gamepad.
+  static float getAxis(size_t id, GamepadAxis axis);
+
+private:
+  Gamepads() = default;
+};
+
+} // namespace Trundle
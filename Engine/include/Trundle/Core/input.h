@@ -21,47 +21,120 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <Trundle/Core/bitSet.h>
+#include <Trundle/Core/gamepad.h>
 #include <Trundle/Core/keyCode.h>
+#include <Trundle/Core/seqLock.h>
 #include <Trundle/Core/util.h>
 #include <Trundle/common.h>
 
-// Temp
-#include <Trundle/Core/application.h>
-
 namespace Trundle {
 
-//===-- Input -------------------------------------------------------------===//
-/// @brief A static singleton that manages which keys are currently pressed.
+//===-- InputSnapshot -----------------------------------------------------===//
+/// @brief An immutable copy of the input state at the start of a frame.
 ///
-/// This manager acts as a central source for keyboard and mouse input into the
-/// engine, as a key press is a global event this seems appropriate. This also
-/// solves the issue with querying if a key is pressed, due to queries being
-/// able to be checked anywhere in code.
+/// Snapshots are plain values, so a thread can hold on to one and query it
+/// without any synchronization, see @ref InputContext::getSnapshot.
 //===----------------------------------------------------------------------===//
-class TRUNDLE_API Input {
+struct InputSnapshot {
+  /// @brief The number of frames that had started when the snapshot was
+  ///        taken.
+  uint64_t frame{0};
+  /// @brief The keys that were pressed.
+  BitSet<384> keysDown;
+  /// @brief The keys that were pressed during the last frame.
+  BitSet<384> keysPressed;
+  /// @brief The keys that were released during the last frame.
+  BitSet<384> keysReleased;
+  /// @brief A bit for each mouse button that was pressed.
+  uint32_t mouseButtonsDown{0};
+  /// @brief The position of the mouse.
+  double mouseX{0};
+  double mouseY{0};
+  /// @brief The distance the mouse moved during the last frame.
+  double mouseDeltaX{0};
+  double mouseDeltaY{0};
+  /// @brief The distance scrolled during the last frame.
+  double scrollX{0};
+  double scrollY{0};
+
+  /// @brief Checks if a key was pressed.
+  bool isKeyDown(KeyCode keycode) const {
+    return keysDown.test(static_cast<size_t>(keycode));
+  }
+
+  /// @brief Checks if a key went down during the last frame.
+  bool wasPressedThisFrame(KeyCode keycode) const {
+    return keysPressed.test(static_cast<size_t>(keycode));
+  }
+
+  /// @brief Checks if a key went up during the last frame.
+  bool wasReleasedThisFrame(KeyCode keycode) const {
+    return keysReleased.test(static_cast<size_t>(keycode));
+  }
+
+  /// @brief Checks if a mouse button was pressed.
+  bool isMouseButtonDown(int buttonNum) const {
+    return (mouseButtonsDown >> buttonNum) & 1;
+  }
+
+  /// @brief Gets the position of the mouse.
+  std::tuple<double, double> getMousePosition() const {
+    return {mouseX, mouseY};
+  }
+
+  /// @brief Gets the distance the mouse moved during the last frame.
+  std::tuple<double, double> getMouseDelta() const {
+    return {mouseDeltaX, mouseDeltaY};
+  }
+
+  /// @brief Gets the distance scrolled during the last frame.
+  std::tuple<double, double> getScrollDelta() const {
+    return {scrollX, scrollY};
+  }
+};
+
+//===-- InputContext ------------------------------------------------------===//
+/// @brief The keyboard, mouse and gamepad state of a single engine instance.
+///
+/// Every @ref Application owns a context, so independent applications can run
+/// on different threads of one process. Code that does not have the
+/// application at hand can use the static @ref Input functions, which forward
+/// to the context that is current on the calling thread.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API InputContext {
 public:
-  /// @brief Queries the system to see if a specific key is pressed.
+  /// @brief Default constructor.
+  InputContext() = default;
+
+  InputContext(const InputContext&) = delete;
+  InputContext& operator=(const InputContext&) = delete;
+
+  /// @brief Queries to see if a specific key is pressed.
   ///
-  /// Checks with the operating system to see if a key is currently pressed,
-  /// this is a slower function but is gaurenteed to be correct.
+  /// Served from the engine's own key state, so it is a single bit test and
+  /// works the same with or without a window. The state can be checked
+  /// against the operating system at the end of every frame, see
+  /// @ref Application::setKeyReconciliation.
   /// @param[in] keycode The key to query.
   /// @return true if the key is currently pressed and false otherwise.
-  // TODO: Maybe remove?
-  static bool isKeyPressed(KeyCode keycode);
+  bool isKeyPressed(KeyCode keycode) const;
 
   /// @brief Sets the key to be in the *pressed* state.
   ///
   /// When a @ref KeyPressEvent has recieved this function is called to hanle
   /// it.
   /// @param[in] keycode The key to set to the *pressed* state.
-  static void setKeyDown(KeyCode keycode);
+  /// @param[in] repeat True if the press is an auto-repeat of a held key,
+  ///                   which does not count as a new press.
+  void setKeyDown(KeyCode keycode, bool repeat = false);
 
   /// @brief Clears the key from being in the *pressed* state.
   ///
   /// When a @ref KeyReleaseEvent has recieved this function is called to hanle
   /// it.
   /// @param[in] keycode The key to set to not being *pressed*.
-  static void setKeyUp(KeyCode keycode);
+  void setKeyUp(KeyCode keycode);
 
   /// @brief Sets a mouse button to be in the *pressed* state.
   ///
@@ -69,7 +142,7 @@ public:
   /// handle it.
   /// @param[in] buttonNum The button to set to the *pressed* state. buttonNum
   ///                      must be either 0, 1, or 2.
-  static void setMouseButtonDown(int buttonNum);
+  void setMouseButtonDown(int buttonNum);
 
   /// @brief Clears the mouse button to be in the *pressed* state.
   ///
@@ -77,33 +150,58 @@ public:
   /// handle it.
   /// @param[in] buttonNum The button to set not being *pressed*. buttonNum
   ///                      must be either 0, 1, or 2.
-  static void setMouseButtonUp(int buttonNum);
+  void setMouseButtonUp(int buttonNum);
 
   /// @brief Sets the mouse position.
   ///
-  /// Tells the input system where the mouse is currently at.
-  /// @param[in] x The x coordinate of the mouse position. Must be positive.
-  /// @param[in] y The y coordinate of the mouse position. Must be positive.
-  static void setMousePosition(double x, double y);
+  /// Tells the input system where the mouse is currently at. The position may
+  /// be negative or outside of the window, for example while the cursor is
+  /// captured for raw mouse motion.
+  /// @param[in] x The x coordinate of the mouse position.
+  /// @param[in] y The y coordinate of the mouse position.
+  void setMousePosition(double x, double y);
 
   /// @brief Sets the mouse position.
   ///
   /// Tells the input system where the mouse is currently at.
-  /// @param[in] x The x coordinate of the mouse position. Must be positive.
-  static void setMousePositionX(double x);
+  /// @param[in] x The x coordinate of the mouse position.
+  void setMousePositionX(double x);
 
   /// @brief Sets the mouse position.
   ///
   /// Tells the input system where the mouse is currently at.
-  /// @param[in] y The y coordinate of the mouse position. Must be positive.
-  static void setMousePositionY(double y);
+  /// @param[in] y The y coordinate of the mouse position.
+  void setMousePositionY(double y);
+
+  /// @brief Adds to the distance the mouse has moved this frame.
+  ///
+  /// When a @ref MouseMoveEvent has recieved this function is called with its
+  /// delta, so every cursor sample between two frames is counted rather than
+  /// just the last position.
+  /// @param[in] dx The distance moved along x.
+  /// @param[in] dy The distance moved along y.
+  void addMouseDelta(double dx, double dy);
+
+  /// @brief Adds to the distance scrolled this frame.
+  ///
+  /// When a @ref MouseScrollEvent has recieved this function is called to
+  /// handle it.
+  /// @param[in] x The distance scrolled along x.
+  /// @param[in] y The distance scrolled along y.
+  void addScroll(double x, double y);
 
   /// @brief Dispatcher function to handle each key that is pressed.
   ///
   /// Allows arbitrary code to determine how a keypress should be handled.
-  /// @param[in] func A function that is run on each of the keys that are
-  ///                 currently pressed.
-  static void handleKeysDown(std::function<void(KeyCode)> func);
+  /// Only the keys that are pressed are visited, so this is almost free when
+  /// no keys are held, and func is called directly so it can be inlined.
+  /// @param[in] func A callable that accepts a @ref KeyCode, run on each of
+  ///                 the keys that are currently pressed in ascending order.
+  template <typename Func>
+  void handleKeysDown(Func&& func) const {
+    keysDown.forEachSet(
+        [&func](size_t key) { func(static_cast<KeyCode>(key)); });
+  }
 
   /// @brief Queries to see if a specific key is pressed.
   ///
@@ -111,7 +209,7 @@ public:
   /// which remains true until the @ref KeyReleaseEvent has been handled.
   /// @param[in] keycode The key to query.
   /// @return true if the key is currently pressed and false otherwise.
-  static bool isKeyDown(KeyCode keycode);
+  bool isKeyDown(KeyCode keycode) const;
 
   /// @brief Queries to see if a specific key is pressed.
   ///
@@ -119,7 +217,41 @@ public:
   /// which remains true until the @ref KeyReleaseEvent has been handled.
   /// @param[in] keycode The key to query.
   /// @return false if the key is currently pressed and true otherwise.
-  static bool isKeyUp(KeyCode keycode);
+  bool isKeyUp(KeyCode keycode) const;
+
+  /// @brief Checks if a key went down during the last frame.
+  ///
+  /// A key that was pressed and released within the same frame counts as
+  /// both pressed and released, so short taps are never missed. Key repeats
+  /// do not count as presses.
+  /// @param[in] keycode The key to query.
+  /// @return true if the key was pressed this frame and false otherwise.
+  bool wasPressedThisFrame(KeyCode keycode) const;
+
+  /// @brief Checks if a key went up during the last frame.
+  ///
+  /// @see wasPressedThisFrame
+  /// @param[in] keycode The key to query.
+  /// @return true if the key was released this frame and false otherwise.
+  bool wasReleasedThisFrame(KeyCode keycode) const;
+
+  /// @brief Starts a new frame of input.
+  ///
+  /// Computes which keys were pressed and released since the last call by
+  /// comparing the key state with a copy from the previous frame, totals the
+  /// mouse motion and scrolling since the last call, then publishes the
+  /// result as a new @ref InputSnapshot. Called by the @ref Application once
+  /// the events of a frame have been handled and before the layers are
+  /// updated.
+  void beginFrame();
+
+  /// @brief Gets the input state published at the start of the frame.
+  ///
+  /// Unlike the other queries this is safe to call from any thread while the
+  /// owning thread is handling events. It never blocks and always returns a
+  /// consistent state from a single frame.
+  /// @return A copy of the latest snapshot.
+  InputSnapshot getSnapshot() const;
 
   /// @brief Check to see if a specific mouse button is pressed.
   ///
@@ -128,7 +260,7 @@ public:
   /// @param[in] buttonNum The mouse button to check. buttonNum must be either
   ///                      0, 1, or 2.
   /// @return true if the button is currently pressed and false otherwise.
-  static bool isMouseButtonDown(int buttonNum);
+  bool isMouseButtonDown(int buttonNum) const;
 
   /// @brief Check to see if a specific mouse button is released.
   ///
@@ -137,35 +269,237 @@ public:
   /// @param[in] buttonNum The mouse button to check. buttonNum must be either
   ///                      0, 1, or 2.
   /// @return false if the button is currently pressed and true otherwise.
-  static bool isMouseButtonUp(int buttonNum);
+  bool isMouseButtonUp(int buttonNum) const;
 
   /// @brief Gets the current mouse position.
   ///
   /// Returns the mouses last known x,y coordinates.
   /// @return A tuple containing the x and y coordinates.
-  static std::tuple<double, double> getMousePosition();
+  std::tuple<double, double> getMousePosition() const;
 
   /// @brief Gets the current mouse position.
   ///
   /// Returns the mouses last known x,y coordinates.
   /// @return The y coordinate.
-  static double getMousePositionX();
+  double getMousePositionX() const;
 
   /// @brief Gets the current mouse position.
   ///
   /// Returns the mouses last known y coordinate.
   /// @return The y coordinate.
-  static double getMousePositionY();
+  double getMousePositionY() const;
+
+  /// @brief Gets the distance the mouse moved during the last frame.
+  ///
+  /// This is the sum of every move between the last two calls to
+  /// @ref beginFrame, so it does not depend on the frame rate the way the
+  /// difference between two positions sampled once a frame does.
+  /// @return A tuple containing the x and y distance.
+  std::tuple<double, double> getMouseDelta() const;
+
+  /// @brief Gets the distance scrolled during the last frame.
+  ///
+  /// @return A tuple containing the x and y distance.
+  std::tuple<double, double> getScrollDelta() const;
+
+  /// @brief Gets the gamepads of this context.
+  inline GamepadContext& getGamepads() { return gamepads; }
+  inline const GamepadContext& getGamepads() const { return gamepads; }
 
 private:
-  Input() = default;
+  // A set of the keys, rounded up to a whole number of 64 bit words.
+  using KeySet = BitSet<384>;
+  static_assert(KeyCodeCount <= 384, "KeySet is too small for every KeyCode");
+
+  // The keys that are currently pressed.
+  KeySet keysDown;
+  // The keys that were pressed at the start of the last frame.
+  KeySet previousKeysDown;
+  // The keys that went down or up since the start of the last frame,
+  // including repeats, used to catch taps that start and end in one frame.
+  KeySet keysPressedLatch;
+  KeySet keysReleasedLatch;
+  // The keys that were pressed and released in the last frame.
+  KeySet keysPressed;
+  KeySet keysReleased;
+  std::array<bool, 3> mouseButtonsDown{};
+  double mouseX{0};
+  double mouseY{0};
+  // The mouse motion and scrolling accumulated since the start of the frame.
+  double pendingDeltaX{0}, pendingDeltaY{0};
+  double pendingScrollX{0}, pendingScrollY{0};
+  // The mouse motion and scrolling of the last frame.
+  double mouseDeltaX{0}, mouseDeltaY{0};
+  double scrollX{0}, scrollY{0};
+
+  // The number of frames that have been started.
+  uint64_t frame{0};
+  // The state published for other threads at the start of each frame.
+  SeqLock<InputSnapshot> snapshot;
+
+  // The state of the gamepads.
+  GamepadContext gamepads;
+};
+
+//===-- Input -------------------------------------------------------------===//
+/// @brief Static access to the input of the current @ref InputContext.
+///
+/// This acts as a central source for keyboard and mouse input into the
+/// engine, so that queries can be checked anywhere in code. Each function
+/// forwards to the context that is current on the calling thread, see
+/// @ref InputContext for the details of each. A thread that has not made a
+/// context current uses the context of the primary @ref Application, or a
+/// default context shared by the whole process if there is none.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API Input {
+public:
+  /// @brief Gets the context that is current on the calling thread.
+  ///
+  /// @return The current context, else the primary context, else the
+  ///         default context.
+  static InputContext& getContext();
+
+  /// @brief Makes a context current on the calling thread.
+  ///
+  /// The @ref Application does this for its own context whenever it runs.
+  /// @param[in] context The context to use, or nullptr to fall back to the
+  ///                    primary context.
+  static void setContext(InputContext* context);
+
+  /// @brief Forgets a context that is about to be destroyed.
+  ///
+  /// Every thread that has the context current falls back to the primary
+  /// context the next time it uses @ref getContext, and the context stops
+  /// being the primary one.
+  /// @param[in] context The context to forget.
+  static void removeContext(InputContext* context);
+
+  /// @brief Sets the context used by threads that have not set their own.
+  ///
+  /// The first @ref Application constructed in the process sets its own
+  /// context, which is cleared again by @ref removeContext.
+  /// @param[in] context The primary context, or nullptr to use the default
+  ///                    context.
+  static void setPrimaryContext(InputContext* context);
+
+  /// @brief Queries to see if a specific key is pressed.
+  static bool isKeyPressed(KeyCode keycode) {
+    return getContext().isKeyPressed(keycode);
+  }
+
+  /// @brief Sets the key to be in the *pressed* state.
+  static void setKeyDown(KeyCode keycode, bool repeat = false) {
+    getContext().setKeyDown(keycode, repeat);
+  }
+
+  /// @brief Clears the key from being in the *pressed* state.
+  static void setKeyUp(KeyCode keycode) { getContext().setKeyUp(keycode); }
+
+  /// @brief Sets a mouse button to be in the *pressed* state.
+  static void setMouseButtonDown(int buttonNum) {
+    getContext().setMouseButtonDown(buttonNum);
+  }
+
+  /// @brief Clears the mouse button to be in the *pressed* state.
+  static void setMouseButtonUp(int buttonNum) {
+    getContext().setMouseButtonUp(buttonNum);
+  }
+
+  /// @brief Sets the mouse position.
+  static void setMousePosition(double x, double y) {
+    getContext().setMousePosition(x, y);
+  }
+
+  /// @brief Sets the mouse position.
+  static void setMousePositionX(double x) {
+    getContext().setMousePositionX(x);
+  }
+
+  /// @brief Sets the mouse position.
+  static void setMousePositionY(double y) {
+    getContext().setMousePositionY(y);
+  }
+
+  /// @brief Adds to the distance the mouse has moved this frame.
+  static void addMouseDelta(double dx, double dy) {
+    getContext().addMouseDelta(dx, dy);
+  }
+
+  /// @brief Adds to the distance scrolled this frame.
+  static void addScroll(double x, double y) { getContext().addScroll(x, y); }
 
-  // Note: Trundle::Key has 325 key codes.
-  // A simple bitmask of which keys are currently pressed.
-  static std::array<bool, 325> keysDown;
-  static std::array<bool, 3> mouseButtonsDown;
-  static double mouseX;
-  static double mouseY;
+  /// @brief Dispatcher function to handle each key that is pressed.
+  template <typename Func>
+  static void handleKeysDown(Func&& func) {
+    getContext().handleKeysDown(std::forward<Func>(func));
+  }
+
+  /// @brief Queries to see if a specific key is pressed.
+  static bool isKeyDown(KeyCode keycode) {
+    return getContext().isKeyDown(keycode);
+  }
+
+  /// @brief Queries to see if a specific key is not pressed.
+  static bool isKeyUp(KeyCode keycode) { return getContext().isKeyUp(keycode); }
+
+  /// @brief Checks if a key went down during the last frame.
+  static bool wasPressedThisFrame(KeyCode keycode) {
+    return getContext().wasPressedThisFrame(keycode);
+  }
+
+  /// @brief Checks if a key went up during the last frame.
+  static bool wasReleasedThisFrame(KeyCode keycode) {
+    return getContext().wasReleasedThisFrame(keycode);
+  }
+
+  /// @brief Starts a new frame of input.
+  static void beginFrame() { getContext().beginFrame(); }
+
+  /// @brief Gets the input state published at the start of the frame.
+  ///
+  /// Safe to call from any thread. A thread that never ran an application
+  /// reads the snapshot of the primary application, so code that watches a
+  /// specific application should capture `app.getInput()` and call
+  /// @ref InputContext::getSnapshot on it instead.
+  static InputSnapshot getSnapshot() { return getContext().getSnapshot(); }
+
+  /// @brief Check to see if a specific mouse button is pressed.
+  static bool isMouseButtonDown(int buttonNum) {
+    return getContext().isMouseButtonDown(buttonNum);
+  }
+
+  /// @brief Check to see if a specific mouse button is released.
+  static bool isMouseButtonUp(int buttonNum) {
+    return getContext().isMouseButtonUp(buttonNum);
+  }
+
+  /// @brief Gets the current mouse position.
+  static std::tuple<double, double> getMousePosition() {
+    return getContext().getMousePosition();
+  }
+
+  /// @brief Gets the current mouse position.
+  static double getMousePositionX() {
+    return getContext().getMousePositionX();
+  }
+
+  /// @brief Gets the current mouse position.
+  static double getMousePositionY() {
+    return getContext().getMousePositionY();
+  }
+
+  /// @brief Gets the distance the mouse moved during the last frame.
+  static std::tuple<double, double> getMouseDelta() {
+    return getContext().getMouseDelta();
+  }
+
+  /// @brief Gets the distance scrolled during the last frame.
+  static std::tuple<double, double> getScrollDelta() {
+    return getContext().getScrollDelta();
+  }
+
+private:
+  Input() = default;
 };
 
-} // namespace Trundle
\ No newline at end of file
+} // namespace Trundle
@@ -0,0 +1,148 @@
+//===-- inputActions.h ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// Maps keys and mouse buttons to the actions of a game, resolved once per
+/// frame.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/bitSet.h>
+#include <Trundle/Core/input.h>
+#include <Trundle/Core/keyCode.h>
+#include <Trundle/Core/util.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+/// @brief The index of an action in an @ref InputActions.
+using ActionId = uint32_t;
+
+/// @brief The state of an action during a frame.
+struct ActionState {
+  /// @brief Whether any binding of the action is held.
+  bool down{false};
+  /// @brief Whether the action became held this frame.
+  bool pressed{false};
+  /// @brief Whether the action stopped being held this frame.
+  bool released{false};
+};
+
+//===-- InputActions ------------------------------------------------------===//
+/// @brief A table of the logical actions of a game and the input bound to
+///        them.
+///
+/// Each binding is a chord of keys and mouse buttons that must all be held,
+/// and is compiled into bitmasks when it is added. An action can have any
+/// number of bindings and is held while any of them are. @ref update then
+/// resolves every action in one pass over the bindings, so checking an action
+/// is a single array lookup no matter how many keys are bound to it.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API InputActions {
+public:
+  /// @brief Adds a new action without any bindings.
+  ///
+  /// @param[in] name The name of the action.
+  /// @return The index to query the action by.
+  ActionId addAction(const std::string& name);
+
+  /// @brief Adds a chord that holds an action.
+  ///
+  /// @param[in] action The action to bind, returned by @ref addAction.
+  /// @param[in] keys The keys that must all be held.
+  /// @param[in] mouseButtons The mouse buttons that must all be held, each of
+  ///                         them must be either 0, 1, or 2.
+  void bind(ActionId action, std::initializer_list<KeyCode> keys,
+            std::initializer_list<int> mouseButtons = {});
+
+  /// @brief Removes every binding of an action.
+  ///
+  /// @param[in] action The action to unbind.
+  void unbind(ActionId action);
+
+  /// @brief Finds an action by name.
+  ///
+  /// This is meant for setting up bindings, actions should be queried by
+  /// index while running.
+  /// @param[in] name The name of the action.
+  /// @return The index of the action or @ref InvalidAction if there is none.
+  ActionId findAction(const std::string& name) const;
+
+  /// @brief Resolves the state of every action for a new frame.
+  ///
+  /// A chord that was pressed and released again within the frame is not
+  /// held, but its action is reported as both pressed and released so that
+  /// quick taps are not lost. Only the order of the events would show if the
+  /// keys of a chord were tapped together, so a chord only counts as tapped
+  /// when every key but one is still held. Mouse buttons have no edges in
+  /// the snapshot and must be held.
+  /// @param[in] input The input state of the frame.
+  void update(const InputSnapshot& input);
+
+  /// @brief Checks if an action is held.
+  inline bool isDown(ActionId action) const {
+    return getState(action).down;
+  }
+
+  /// @brief Checks if an action became held this frame.
+  inline bool wasPressed(ActionId action) const {
+    return getState(action).pressed;
+  }
+
+  /// @brief Checks if an action stopped being held this frame.
+  inline bool wasReleased(ActionId action) const {
+    return getState(action).released;
+  }
+
+  /// @brief Gets the state of an action.
+  ///
+  /// @param[in] action The action to query.
+  /// @return The state of the action in the last call to @ref update.
+  inline const ActionState& getState(ActionId action) const {
+    assert(action < states.size() && "Error: Unknown action.");
+    return states[action];
+  }
+
+  /// @brief Gets the state of every action, indexed by @ref ActionId.
+  inline const std::vector<ActionState>& getStates() const { return states; }
+
+  /// @brief Gets the name of an action.
+  const std::string& getName(ActionId action) const;
+
+  /// @brief Gets the number of actions.
+  inline size_t size() const { return states.size(); }
+
+  /// @brief An index that does not refer to any action.
+  static constexpr ActionId InvalidAction = ~ActionId(0);
+
+private:
+  // A chord compiled to the bits that must be set for it to be held.
+  struct Binding {
+    BitSet<384> keys;
+    uint32_t mouseButtons{0};
+    ActionId action{InvalidAction};
+  };
+
+  // Every binding of every action, in the order that they were added.
+  std::vector<Binding> bindings;
+  // The state and name of each action, indexed by ActionId.
+  std::vector<ActionState> states;
+  std::vector<std::string> names;
+};
+
+} // namespace Trundle
@@ -0,0 +1,139 @@
+//===-- inputHistory.h ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A ring of the input state of recent frames, used to re-simulate frames for
+/// rollback and prediction.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/bitSet.h>
+#include <Trundle/Core/input.h>
+#include <Trundle/Core/keyCode.h>
+#include <Trundle/Core/util.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+/// @brief The input state of a single frame.
+///
+/// Only the held state is stored, presses and releases are recovered by
+/// comparing a record with the one before it.
+struct InputRecord {
+  /// @brief The frame that the record belongs to.
+  uint64_t frame{0};
+  /// @brief The keys that were pressed.
+  BitSet<384> keysDown;
+  /// @brief A bit for each mouse button that was pressed.
+  uint32_t mouseButtonsDown{0};
+  /// @brief The position of the mouse.
+  double mouseX{0};
+  double mouseY{0};
+
+  /// @brief Builds a record from the state published for a frame.
+  static InputRecord fromSnapshot(const InputSnapshot& snapshot);
+
+  /// @brief The number of bytes that a record is serialized to.
+  static constexpr size_t SerializedSize =
+      8 + BitSet<384>::WordCount * 8 + 4 + 8 + 8;
+};
+
+//===-- InputHistory ------------------------------------------------------===//
+/// @brief A fixed size ring of the most recent @ref InputRecord\ s.
+///
+/// The ring is allocated once, so recording and looking up frames never
+/// allocates. A record for frame f lives in slot f % capacity, so finding a
+/// frame is a single mask and compare.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API InputHistory {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] capacity The number of frames to keep, must be a power of
+  ///                     two.
+  explicit InputHistory(size_t capacity = 64);
+
+  /// @brief Adds the record of a frame, replacing the oldest if the ring is
+  ///        full.
+  ///
+  /// @param[in] record The record to add, its frame must be after the newest
+  ///                   frame in the history.
+  void push(const InputRecord& record);
+
+  /// @brief Finds the record of a frame.
+  ///
+  /// @param[in] frame The frame to find.
+  /// @return The record, or nullptr if the frame is not in the history.
+  const InputRecord* get(uint64_t frame) const;
+
+  /// @brief Checks if a key went down in a frame.
+  ///
+  /// @param[in] frame The frame to check, the frame before it must also be
+  ///                  in the history.
+  /// @param[in] keycode The key to check.
+  /// @return true if the key was up in the previous frame and down in this
+  ///         one, false otherwise.
+  bool wasPressed(uint64_t frame, KeyCode keycode) const;
+
+  /// @brief Checks if a key went up in a frame.
+  ///
+  /// @see wasPressed
+  bool wasReleased(uint64_t frame, KeyCode keycode) const;
+
+  /// @brief Gets the oldest frame in the history.
+  inline uint64_t getOldestFrame() const { return newest + 1 - count; }
+
+  /// @brief Gets the newest frame in the history.
+  inline uint64_t getNewestFrame() const { return newest; }
+
+  /// @brief Gets the number of frames in the history.
+  inline size_t size() const { return count; }
+
+  /// @brief Gets the maximum number of frames in the history.
+  inline size_t capacity() const { return records.size(); }
+
+  /// @brief Removes every record.
+  void clear();
+
+  /// @brief Writes the history to a buffer.
+  ///
+  /// Records are written from oldest to newest with every field in little
+  /// endian byte order, so the same history produces the same bytes on every
+  /// platform.
+  /// @param[out] out The buffer to append to.
+  void serialize(std::vector<uint8_t>& out) const;
+
+  /// @brief Replaces the history with one written by @ref serialize.
+  ///
+  /// @param[in] data The serialized history.
+  /// @param[in] size The number of bytes in data.
+  /// @return true if the data was read, false if it was malformed, in which
+  ///         case the history is left empty.
+  bool deserialize(const uint8_t* data, size_t size);
+
+private:
+  // Storage for the records, indexed by frame & mask.
+  std::vector<InputRecord> records;
+  size_t mask;
+  // The number of records in the ring.
+  size_t count{0};
+  // The newest frame in the ring.
+  uint64_t newest{0};
+};
+
+} // namespace Trundle
@@ -21,6 +21,8 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <cstddef>
+
 namespace Trundle {
 
 enum class KeyCode {
@@ -352,4 +354,8 @@ enum class KeyCode {
   Joystick8Button19
 };
 
+/// @brief The number of values in @ref KeyCode.
+constexpr size_t KeyCodeCount =
+    static_cast<size_t>(KeyCode::Joystick8Button19) + 1;
+
 } // namespace Trundle
\ No newline at end of file
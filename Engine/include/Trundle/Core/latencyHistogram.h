@@ -0,0 +1,100 @@
+//===-- latencyHistogram.h ------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A fixed size histogram of latencies, used to report how long input takes
+/// to reach the screen each frame.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/clock.h>
+#include <Trundle/Core/util.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+//===-- LatencyHistogram --------------------------------------------------===//
+/// @brief A histogram of latencies with power of two buckets.
+///
+/// Bucket 0 counts latencies of 0ns and bucket i counts latencies in
+/// [2^(i-1), 2^i) nanoseconds, so recording a sample is a bit scan and an
+/// increment and the histogram never allocates.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API LatencyHistogram {
+public:
+  /// @brief The number of buckets in the histogram.
+  static constexpr size_t BucketCount = 65;
+
+  /// @brief Adds a latency to the histogram.
+  ///
+  /// @param[in] latency The latency in nanoseconds.
+  void record(Timestamp latency);
+
+  /// @brief Removes every latency from the histogram.
+  void clear();
+
+  /// @brief Gets the number of latencies that have been recorded.
+  inline size_t getCount() const { return count; }
+
+  /// @brief Gets the smallest latency recorded, or 0 if there are none.
+  inline Timestamp getMin() const { return count ? min : 0; }
+
+  /// @brief Gets the largest latency recorded, or 0 if there are none.
+  inline Timestamp getMax() const { return max; }
+
+  /// @brief Gets the mean latency, or 0 if there are none.
+  Timestamp getMean() const;
+
+  /// @brief Estimates a percentile of the recorded latencies.
+  ///
+  /// The estimate is the upper bound of the bucket that the percentile falls
+  /// in, clamped to the largest latency recorded.
+  /// @param[in] percentile The percentile to find, between 0 and 100.
+  /// @return The estimated latency, or 0 if there are none.
+  Timestamp getPercentile(double percentile) const;
+
+  /// @brief Gets the number of latencies recorded in each bucket.
+  inline const std::array<uint32_t, BucketCount>& getBuckets() const {
+    return buckets;
+  }
+
+  /// @brief Finds the bucket that a latency is counted in.
+  ///
+  /// @param[in] latency The latency in nanoseconds.
+  /// @return The index of the bucket.
+  static size_t getBucket(Timestamp latency);
+
+  /// @brief Summarises the histogram for logging.
+  ///
+  /// @return A string with the count, mean, 99th percentile and max.
+  std::string toString() const;
+
+private:
+  // The number of latencies in each bucket.
+  std::array<uint32_t, BucketCount> buckets{};
+  // The number of latencies recorded.
+  size_t count{0};
+  // The sum of every latency recorded.
+  Timestamp total{0};
+  // The smallest latency recorded.
+  Timestamp min{~Timestamp(0)};
+  // The largest latency recorded.
+  Timestamp max{0};
+};
+
+} // namespace Trundle
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <Trundle/common.h>
+#include <Trundle/Core/timestep.h>
 #include <Trundle/Core/util.h>
 #include <Trundle/Events/event.h>
 
@@ -54,6 +55,23 @@ public:
   /// @brief Function called on each frame so long as the layer is attached.
   virtual void onUpdate();
 
+  /// @brief Function called on each update so long as the layer is attached.
+  ///
+  /// When the @ref Application has a fixed timestep this is called zero or
+  /// more times per frame, always with the same step, otherwise it is called
+  /// once per frame with the time since the last frame. By default this
+  /// calls @ref onUpdate().
+  /// @param[in] step The amount of time that the update covers.
+  virtual void onUpdate(Timestep step);
+
+  /// @brief Function called once per frame after the updates, before the
+  ///        frame is presented.
+  ///
+  /// @param[in] alpha How far the frame is between the last update and the
+  ///                  next, from 0 to 1, used to interpolate state when the
+  ///                  application has a fixed timestep. Always 1 otherwise.
+  virtual void onRender(float alpha);
+
   /// @brief Function called when an @ref Event occures.
   ///
   /// This function gives each layer an opportunity to handle an @ref Event if
@@ -67,9 +85,88 @@ public:
   /// @return The name of the layer.
   const std::string& getName();
 
+  /// @brief Checks if the layer wants to receive a type of event.
+  ///
+  /// @param[in] type The type of event.
+  /// @return true if @ref onEvent should be called for the type, false
+  ///         otherwise.
+  bool isSubscribed(EventType type) const;
+
+  /// @brief Checks if the layer has declared what its @ref onUpdate touches.
+  ///
+  /// @return true if the layer has declared any resources it reads or
+  ///         writes, false otherwise.
+  bool hasDependencies() const;
+
+  /// @brief Returns the resources that the layer reads during @ref onUpdate.
+  const std::vector<std::string>& getReads() const;
+
+  /// @brief Returns the resources that the layer writes during @ref onUpdate.
+  const std::vector<std::string>& getWrites() const;
+
+  /// @brief Returns the names of the layers that must be updated first.
+  const std::vector<std::string>& getRunsAfter() const;
+
 protected:
+  /// @brief Declares that the layer wants to receive a type of event.
+  ///
+  /// A layer that never subscribes receives every event. Once a layer
+  /// subscribes it only receives the types that it has subscribed to.
+  /// Subscriptions are read when the layer is pushed, so they should be made
+  /// in the constructor.
+  /// @param[in] type The type of event to receive.
+  void subscribe(EventType type);
+
+  /// @brief Declares that the layer wants to receive a category of events.
+  ///
+  /// @see subscribe(EventType)
+  /// @param[in] category The categories of events to receive.
+  void subscribe(EventCategory category);
+
+  /// @brief Declares that @ref onUpdate reads a resource.
+  ///
+  /// Resources are named by the application, for example "audio" or
+  /// "physics". A layer that never declares a resource is assumed to touch
+  /// everything and is updated on its own in stack order. Once a layer
+  /// declares a resource it may be updated at the same time as any layer
+  /// that does not write what it reads or read what it writes. Dependencies
+  /// are read when the layer is pushed, so they should be declared in the
+  /// constructor.
+  /// @param[in] resource The name of the resource.
+  void reads(const std::string& resource);
+
+  /// @brief Declares that @ref onUpdate writes a resource.
+  ///
+  /// @see reads
+  /// @param[in] resource The name of the resource.
+  void writes(const std::string& resource);
+
+  /// @brief Declares that the layer must be updated after another layer.
+  ///
+  /// The ordering holds even if the other layer is above this one in the
+  /// stack. It has no effect if no layer with the name is in the stack. This
+  /// only orders the layers, it does not declare a resource, so a layer that
+  /// only calls this is still assumed to touch everything.
+  /// @see reads
+  /// @param[in] layer The name of the other layer.
+  void runsAfter(const std::string& layer);
+
   /// The name of the layer.
   std::string name;
+
+private:
+  // A bitmask of the event types that the layer receives, indexed by
+  // EventType.
+  uint32_t subscriptions{~0u};
+  // A flag that is set once the layer has narrowed its subscriptions.
+  bool subscribed{false};
+
+  // The dependencies of onUpdate, see reads.
+  std::vector<std::string> readSet;
+  std::vector<std::string> writeSet;
+  std::vector<std::string> afterSet;
+  // A flag that is set once the layer has declared a resource.
+  bool declared{false};
 };
 
 } // namespace Trundle
\ No newline at end of file
@@ -32,6 +32,20 @@
 
 namespace Trundle {
 
+/// @brief Identifies a layer in a @ref LayerStack.
+///
+/// A handle is invalidated when its layer is popped, even if the slot is later
+/// reused by another layer.
+struct LayerHandle {
+  uint32_t index{~0u};
+  uint32_t generation{0};
+
+  bool operator==(const LayerHandle& other) const {
+    return index == other.index && generation == other.generation;
+  }
+  bool operator!=(const LayerHandle& other) const { return !(*this == other); }
+};
+
 class TRUNDLE_API LayerStack {
 public:
   /// @brief Default constructor.
@@ -42,19 +56,27 @@ public:
 
   /// @brief Adds a new layer to the stack.
   ///
-  /// @param[in] layer The layer to add to the stack.
-  void pushLayer(Ref<Layer> layer);
+  /// While the stack is being traversed the layer is only added when
+  /// @ref applyPending is called, see @ref beginTraversal.
+  /// @param[in] layer The layer to add to the stack, it must not already be
+  ///                  in the stack.
+  /// @return A handle to the layer.
+  LayerHandle pushLayer(Ref<Layer> layer);
 
   /// @brief Adds an overlayer layer to the stack.
   ///
   /// Overlay layers are special layers that sit on the top-most portion of
   /// the stack and are used for layers that control the overlay. This is so
   /// that overlay layers have a chance to handle @ref Events first.
-  /// @param[in] overlay The layer to add to the stack.
-  void pushOverlay(Ref<Layer> overlay);
+  /// @param[in] overlay The layer to add to the stack, it must not already be
+  ///                    in the stack.
+  /// @return A handle to the layer.
+  LayerHandle pushOverlay(Ref<Layer> overlay);
 
   /// @brief Removes a specific layer from the stack.
   ///
+  /// Does nothing if the layer is not in the stack. While the stack is being
+  /// traversed the layer is only removed when @ref applyPending is called.
   /// @param[in] layer The layer to remove from the stack.
   void popLayer(Ref<Layer> layer);
 
@@ -66,6 +88,34 @@ public:
   /// @param[in] overlay The layer to remove from the stack.
   void popOverlay(Ref<Layer> overlay);
 
+  /// @brief Removes the layer that a handle refers to.
+  ///
+  /// Does nothing if the handle is no longer valid.
+  /// @param[in] handle The layer to remove from the stack.
+  void pop(LayerHandle handle);
+
+  /// @brief Finds the layer that a handle refers to.
+  ///
+  /// @param[in] handle The handle of the layer.
+  /// @return The layer, or nullptr if it has been popped.
+  Layer* get(LayerHandle handle) const;
+
+  /// @brief Marks the start of a traversal of the stack.
+  ///
+  /// Until the matching @ref endTraversal, pushes and pops are queued rather
+  /// than applied, so the layers being walked are never moved or destroyed.
+  /// Traversals may be nested.
+  void beginTraversal();
+
+  /// @brief Marks the end of a traversal of the stack.
+  void endTraversal();
+
+  /// @brief Applies the pushes and pops that were queued during traversals.
+  ///
+  /// Called by the @ref Application at the end of every frame. Does nothing
+  /// while the stack is being traversed.
+  void applyPending();
+
   /// @brief Returns an iterator to the begining of the stack.
   ///
   /// Allows for looping through the stack.
@@ -78,6 +128,35 @@ public:
   /// @returns An iterator that points to the end of the stack.
   std::vector<Ref<Layer>>::reverse_iterator end();
 
+  /// @brief Returns every layer in the stack without taking ownership.
+  ///
+  /// The layers are contiguous and in the same top to bottom order as
+  /// iterating the stack, so walking them every frame does not touch any
+  /// reference counts. The pointers stay valid until the stack is changed.
+  /// @return The layers in the stack.
+  const std::vector<Layer*>& getLayers() const;
+
+  /// @brief Returns the layers grouped into levels that can be updated at the
+  ///        same time.
+  ///
+  /// The levels are built from the dependencies declared by each layer (see
+  /// @ref Layer::reads) whenever the stack changes. The layers are put in
+  /// stack order, then moved after any layer they must run after, and every
+  /// layer is placed in a later level than the layers before it that it
+  /// conflicts with. Layers within a level keep that order, so updating the
+  /// levels one after another gives the same result as updating the layers
+  /// one at a time. If the runsAfter declarations form a cycle an error is
+  /// logged and every layer is given its own level, in stack order.
+  /// @return The levels, in the order that they must be updated.
+  const std::vector<std::vector<Layer*>>& getUpdateLevels() const;
+
+  /// @brief Returns the layers that are subscribed to a type of event.
+  ///
+  /// The layers are in the same top to bottom order as iterating the stack.
+  /// @param[in] type The type of event.
+  /// @return The subscribed layers.
+  const std::vector<Layer*>& getSubscribers(EventType type) const;
+
   /// @breif Returns the size of the stack.
   ///
   /// Returns the number of layers that are currently in the stack.
@@ -87,10 +166,66 @@ public:
 private:
   // Our representation of the stack of layers is a simple vector.
   std::vector<Ref<Layer>> layers;
+  // The slot of each entry of layers.
+  std::vector<uint32_t> layerSlots;
 
   // An index pointer to the current top of the stack of normal layers (and not
   // overlay layers).
   size_t it;
+
+  // A non-owning copy of the layers, from the top of the stack to the bottom.
+  std::vector<Layer*> view;
+
+  // The layers subscribed to each type of event, indexed by EventType.
+  std::array<std::vector<Layer*>, EventTypeCount> subscribers;
+
+  // The layers grouped by the dependencies between their updates.
+  std::vector<std::vector<Layer*>> levels;
+
+  // The position of a layer whose push has not been applied yet.
+  static constexpr size_t NoPosition = ~size_t(0);
+  // The layer that each handle refers to, the generation is bumped whenever a
+  // slot is freed so that old handles no longer match.
+  struct Slot {
+    Layer* layer{nullptr};
+    // Owns the layer until its push is applied, then the stack does.
+    Ref<Layer> pending;
+    // The index of the layer in layers, so popping it needs no search.
+    size_t position{NoPosition};
+    // Whether a pop of the layer is waiting for the traversal to end.
+    bool popQueued{false};
+    uint32_t generation{0};
+  };
+  std::vector<Slot> slots;
+  std::vector<uint32_t> freeSlots;
+  // The slot of each layer, used to pop layers by reference.
+  std::unordered_map<Layer*, uint32_t> slotOf;
+
+  // A change to the stack that was requested during a traversal.
+  enum class CommandType { PushLayer, PushOverlay, Pop };
+  struct Command {
+    CommandType type;
+    LayerHandle handle;
+  };
+  std::vector<Command> pending;
+  // The number of traversals in progress.
+  uint32_t traversals{0};
+  // Guards the handles and the queue, which layers updated on worker threads
+  // may change at the same time.
+  mutable std::mutex mutex;
+
+  // Gives a layer a slot and requests that it is pushed.
+  LayerHandle push(Ref<Layer> layer, CommandType type);
+  // Applies a change now, or queues it if the stack is being traversed.
+  void request(const Command& command);
+  // Changes the stack.
+  void apply(const Command& command);
+  // Rebuilds the view and subscriber lists after the stack has changed.
+  void updateViews();
+  // Stores the position of every layer from first to the top of the stack.
+  void updatePositions(size_t first);
+  // Rebuilds the update levels from the view.
+  void updateLevels();
 };
 
-} // namespace Trundle
\ No newline at end of file
+} // namespace Trundle
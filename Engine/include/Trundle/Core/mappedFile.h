@@ -0,0 +1,73 @@
+//===-- mappedFile.h ------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A read-only view of a file that is mapped into memory, so large files can
+/// be read without copying them through a stream.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/util.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+//===-- MappedFile --------------------------------------------------------===//
+/// @brief A file that is mapped read-only into the address space.
+///
+/// The contents are paged in by the operating system as they are touched, so
+/// opening a file is cheap regardless of its size. Each platform provides its
+/// own implementation.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API MappedFile {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] path The path of the file to map.
+  explicit MappedFile(const std::string& path);
+
+  /// @brief Default destructor, unmaps the file.
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// @brief Checks if the file was mapped successfully.
+  ///
+  /// @return true if the file is mapped, false otherwise.
+  inline bool isOpen() const { return data != nullptr; }
+
+  /// @brief Gets the contents of the file.
+  ///
+  /// @return A pointer to the first byte of the file or nullptr if the file
+  ///         is not mapped.
+  inline const unsigned char* getData() const { return data; }
+
+  /// @brief Gets the size of the file.
+  ///
+  /// @return The number of bytes in the file.
+  inline size_t getSize() const { return size; }
+
+private:
+  // The start of the mapping.
+  const unsigned char* data{nullptr};
+  // The number of bytes that are mapped.
+  size_t size{0};
+};
+
+} // namespace Trundle
@@ -0,0 +1,133 @@
+//===-- mpscQueue.h -------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A bounded, lock-free queue that any number of threads may push to and a
+/// single thread pops from. Used to pass work and events to the main loop
+/// without taking a lock on every post.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/pointer.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+//===-- MPSCQueue ---------------------------------------------------------===//
+/// @brief A bounded multi-producer, single-consumer queue.
+///
+/// Each slot in the ring carries a sequence number which tells producers
+/// whether it is free and tells the consumer whether it has been written, so
+/// producers only contend on a single compare-and-swap of the tail and never
+/// block each other or the consumer.
+//===----------------------------------------------------------------------===//
+template <typename T>
+class MPSCQueue {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] capacity The maximum number of values that can be queued at
+  ///                     once, must be a power of two.
+  explicit MPSCQueue(size_t capacity)
+    : cells(new Cell[capacity]), mask(capacity - 1) {
+    assert(capacity >= 2 && (capacity & (capacity - 1)) == 0 &&
+           "Capacity must be a power of two");
+    for (size_t i = 0; i < capacity; ++i) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  /// @brief Adds a value to the back of the queue, safe to call from any
+  ///        thread.
+  ///
+  /// @param[in] value The value to add.
+  /// @return true if the value was added and false if the queue was full.
+  bool push(const T& value) {
+    size_t position = tail.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells[position & mask];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+      if (difference == 0) {
+        // The slot is free, try to claim it.
+        if (tail.compare_exchange_weak(position, position + 1,
+                                       std::memory_order_relaxed)) {
+          cell.value = value;
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        // The consumer has not yet freed this slot, so the queue is full.
+        return false;
+      } else {
+        // Another producer claimed the slot first.
+        position = tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// @brief Removes the value at the front of the queue, must only be called
+  ///        from the consuming thread.
+  ///
+  /// @param[out] value Set to the removed value.
+  /// @return true if a value was removed and false if the queue was empty.
+  bool pop(T& value) {
+    Cell& cell = cells[head & mask];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != head + 1) {
+      return false;
+    }
+
+    value = cell.value;
+    cell.sequence.store(head + mask + 1, std::memory_order_release);
+    ++head;
+    return true;
+  }
+
+  /// @brief Checks if there is nothing to pop, must only be called from the
+  ///        consuming thread.
+  ///
+  /// @return true if the queue is empty and false otherwise.
+  bool empty() const {
+    return cells[head & mask].sequence.load(std::memory_order_acquire) !=
+           head + 1;
+  }
+
+  /// @brief Returns the maximum number of values that can be queued.
+  size_t capacity() const { return mask + 1; }
+
+private:
+  // A slot in the ring.
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  Own<Cell[]> cells;
+  size_t mask;
+  // Producers and the consumer are kept on separate cache lines so that they
+  // do not invalidate each other.
+  alignas(64) std::atomic<size_t> tail{0};
+  alignas(64) size_t head{0};
+};
+
+} // namespace Trundle
@@ -0,0 +1,112 @@
+//===-- seqLock.h ---------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A sequence lock, which lets one thread publish a value that any number of
+/// other threads read without locks and without ever seeing a torn copy.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/common.h>
+
+#include <cstring>
+#include <type_traits>
+
+namespace Trundle {
+
+//===-- SeqLock -----------------------------------------------------------===//
+/// @brief Publishes a value from a single writer to many lock-free readers.
+///
+/// The writer bumps a sequence number to an odd value, writes the value and
+/// then bumps the sequence number to the next even value. A reader copies the
+/// value and retries if the sequence number was odd or changed while it was
+/// copying. Writers never wait and readers only retry when they overlap a
+/// write, so it suits small values that are published once per frame.
+///
+/// The value is stored as relaxed atomic words, so concurrent reads of a half
+/// written value are well defined and simply discarded.
+//===----------------------------------------------------------------------===//
+template <typename T>
+class SeqLock {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SeqLock values are copied as raw memory");
+
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] value The initial value.
+  explicit SeqLock(const T& value = T{}) { store(value); }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  /// @brief Publishes a new value, must only be called from one thread.
+  ///
+  /// @param[in] value The value to publish.
+  void store(const T& value) {
+    uint64_t buffer[WordCount] = {};
+    std::memcpy(buffer, &value, sizeof(T));
+
+    uint64_t current = sequence.load(std::memory_order_relaxed);
+    sequence.store(current + 1, std::memory_order_relaxed);
+    // Readers that see any of the new words must also see the odd sequence.
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WordCount; ++i) {
+      words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    sequence.store(current + 2, std::memory_order_release);
+  }
+
+  /// @brief Reads the latest value, safe to call from any thread.
+  ///
+  /// @return A consistent copy of the last published value.
+  T load() const {
+    uint64_t buffer[WordCount];
+    uint64_t before;
+    uint64_t after;
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      for (size_t i = 0; i < WordCount; ++i) {
+        buffer[i] = words[i].load(std::memory_order_relaxed);
+      }
+      // The words must be read before the sequence is checked again.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+
+    T value;
+    std::memcpy(&value, buffer, sizeof(T));
+    return value;
+  }
+
+  /// @brief Gets the number of values that have been published, including
+  ///        the initial value.
+  inline uint64_t getVersion() const {
+    return sequence.load(std::memory_order_acquire) / 2;
+  }
+
+private:
+  static constexpr size_t WordCount = (sizeof(T) + 7) / 8;
+
+  // Odd while a write is in progress, incremented by 2 for each write.
+  alignas(64) std::atomic<uint64_t> sequence{0};
+  // Storage for the value.
+  std::array<std::atomic<uint64_t>, WordCount> words{};
+};
+
+} // namespace Trundle
@@ -0,0 +1,174 @@
+//===-- timerWheel.h ------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A hierarchical timer wheel that schedules timers in constant time and only
+/// touches the timers that are due as time moves forward.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/clock.h>
+#include <Trundle/Core/util.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+/// @brief Identifies a timer scheduled on a @ref TimerWheel.
+///
+/// The generation is bumped every time a slot is reused, so a handle to a
+/// timer that has fired or been cancelled never refers to a newer timer.
+struct TimerHandle {
+  uint32_t index{~0u};
+  uint32_t generation{0};
+
+  bool operator==(const TimerHandle& other) const {
+    return index == other.index && generation == other.generation;
+  }
+  bool operator!=(const TimerHandle& other) const { return !(*this == other); }
+};
+
+//===-- TimerWheel --------------------------------------------------------===//
+/// @brief Schedules one shot and periodic timers.
+///
+/// Time is divided into ticks of a fixed resolution and the wheel has a level
+/// of 64 slots for every 6 bits of the tick count. A timer is stored in the
+/// level of the highest 6 bit group in which its deadline differs from the
+/// current tick, and is moved one level down each time the current tick
+/// reaches the start of its slot, until it reaches the lowest level and fires.
+///
+/// Scheduling and cancelling are constant time, and advancing the wheel only
+/// visits the slots that have timers in them, so pending timers cost nothing
+/// until they are due. Timers are kept in a pool of nodes linked by index,
+/// which does not allocate once it has grown to the peak number of timers.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API TimerWheel {
+public:
+  /// @brief A timer that has fired.
+  struct Expired {
+    TimerHandle handle;
+    uint32_t code;
+  };
+
+  /// @brief Default constructor.
+  ///
+  /// @param[in] now The current time.
+  /// @param[in] resolution The length of a tick in nanoseconds, timers fire
+  ///                       on the first tick at or after their deadline.
+  explicit TimerWheel(Timestamp now = 0, Timestamp resolution = 1000000);
+
+  /// @brief Schedules a timer.
+  ///
+  /// @param[in] deadline The time that the timer should fire at.
+  /// @param[in] code An application defined code passed back when the timer
+  ///                 fires.
+  /// @param[in] period If not 0, the timer fires again every period
+  ///                   nanoseconds until it is cancelled.
+  /// @return A handle to the timer.
+  TimerHandle schedule(Timestamp deadline, uint32_t code,
+                       Timestamp period = 0);
+
+  /// @brief Cancels a timer.
+  ///
+  /// @param[in] handle The timer to cancel.
+  /// @return true if the timer was pending, false if it had already fired or
+  ///         been cancelled.
+  bool cancel(TimerHandle handle);
+
+  /// @brief Checks if a timer has not yet fired or been cancelled.
+  ///
+  /// Periodic timers stay pending until they are cancelled.
+  /// @param[in] handle The timer to check.
+  /// @return true if the timer is pending, false otherwise.
+  bool isPending(TimerHandle handle) const;
+
+  /// @brief Moves the wheel forward, firing every timer that is due.
+  ///
+  /// Timers are appended to expired in the order of their deadlines.
+  /// @param[in] now The current time, must not be before the last call.
+  /// @param[out] expired The timers that have fired.
+  void advance(Timestamp now, std::vector<Expired>& expired);
+
+  /// @brief Gets the number of pending timers.
+  inline size_t size() const { return count; }
+
+  /// @brief Gets the earliest time that the wheel needs to be advanced at.
+  ///
+  /// This is the start of the next occupied slot, which is at or before the
+  /// next deadline, so a caller that sleeps until then and advances the wheel
+  /// never fires a timer late. It is only exact for timers in the finest
+  /// level, otherwise advancing then just moves timers closer to firing.
+  /// @return The time to advance at, or the largest timestamp if there are
+  ///         no pending timers.
+  Timestamp getNextWake() const;
+
+private:
+  // The number of bits of the tick count handled by each level.
+  static constexpr uint32_t LevelBits = 6;
+  static constexpr uint32_t SlotCount = 1u << LevelBits;
+  // Enough levels to cover every 64 bit tick count.
+  static constexpr uint32_t LevelCount = (64 + LevelBits - 1) / LevelBits;
+  // Marks the end of a list of nodes.
+  static constexpr uint32_t None = ~0u;
+
+  struct Node {
+    // The tick that the timer fires on.
+    uint64_t deadline{0};
+    // The number of ticks between firings, or 0 for a one shot timer.
+    uint64_t period{0};
+    uint32_t code{0};
+    uint32_t generation{0};
+    // The neighbours of the node in its slot, or in the free list.
+    uint32_t prev{None};
+    uint32_t next{None};
+    // The slot that the node is in, or None if it is free.
+    uint32_t slot{None};
+  };
+
+  struct Level {
+    // The first node in each slot.
+    std::array<uint32_t, SlotCount> slots;
+    // A bit for each slot that has nodes in it.
+    uint64_t occupied{0};
+  };
+
+  // The length of a tick.
+  Timestamp resolution;
+  // The current tick.
+  uint64_t current;
+  // The number of pending timers.
+  size_t count{0};
+  // The pool of nodes.
+  std::vector<Node> nodes;
+  // The first free node in the pool.
+  uint32_t freeList{None};
+  // The levels of the wheel, from finest to coarsest.
+  std::array<Level, LevelCount> levels;
+
+  // Converts a time to the first tick at or after it.
+  uint64_t toTick(Timestamp time) const;
+  // Links a node into the slot for its deadline.
+  void insert(uint32_t index);
+  // Unlinks a node from its slot.
+  void unlink(uint32_t index);
+  // Returns a node to the pool, invalidating its handle.
+  void release(uint32_t index);
+  // Moves every node in a slot to the slot for its deadline.
+  void cascade(uint32_t level, uint32_t slot);
+};
+
+} // namespace Trundle
@@ -0,0 +1,75 @@
+//===-- timestep.h --------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// The length of time that a layer update covers.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/clock.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+//===-- Timestep ----------------------------------------------------------===//
+/// @brief The amount of time that an update moves the simulation forward by.
+///
+/// Stored in nanoseconds so that fixed steps add up exactly, and converted to
+/// seconds for the floating point maths in layers.
+//===----------------------------------------------------------------------===//
+class Timestep {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] duration The length of the step in nanoseconds.
+  constexpr explicit Timestep(Timestamp duration = 0) : duration(duration) {}
+
+  /// @brief Creates the step of an update that runs at a fixed rate.
+  ///
+  /// @param[in] hertz The number of updates per second, must not be 0.
+  /// @return The step between each update.
+  static constexpr Timestep fromRate(uint32_t hertz) {
+    return Timestep(1000000000ull / hertz);
+  }
+
+  /// @brief Returns the length of the step in nanoseconds.
+  constexpr Timestamp getNanoseconds() const { return duration; }
+
+  /// @brief Returns the length of the step in milliseconds.
+  constexpr float getMilliseconds() const {
+    return static_cast<float>(duration) / 1000000.0f;
+  }
+
+  /// @brief Returns the length of the step in seconds.
+  constexpr float getSeconds() const {
+    return static_cast<float>(duration) / 1000000000.0f;
+  }
+
+  constexpr bool operator==(const Timestep& other) const {
+    return duration == other.duration;
+  }
+  constexpr bool operator!=(const Timestep& other) const {
+    return !(*this == other);
+  }
+
+private:
+  // The length of the step in nanoseconds.
+  Timestamp duration;
+};
+
+} // namespace Trundle
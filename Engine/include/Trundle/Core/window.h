@@ -22,8 +22,11 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <Trundle/Core/clock.h>
+#include <Trundle/Core/keyCode.h>
 #include <Trundle/common.h>
 #include <Trundle/Events/event.h>
+#include <Trundle/Events/eventQueue.h>
 
 namespace Trundle {
 
@@ -61,12 +64,35 @@ struct WindowProperties {
 //===----------------------------------------------------------------------===//
 class Window {
 public:
-  /// @brief An alias for function callback for events.
-  using EventCallback = std::function<void(Event&)>;
-
   /// @brief Default virtual destructor.
   virtual ~Window() {}
 
+  /// @brief Polls the OS for events.
+  ///
+  /// Any events that have occured since the last poll are appended to the
+  /// window's @ref EventQueue rather than being handled immediately.
+  virtual void pollEvents() = 0;
+
+  /// @brief Waits for the OS to send an event, then polls for events.
+  ///
+  /// Lets a loop with nothing to do sleep instead of spinning. Returns early
+  /// when @ref wake is called.
+  /// @param[in] timeout The longest time to wait, in nanoseconds.
+  virtual void waitEvents(Timestamp timeout) = 0;
+
+  /// @brief Wakes a thread that is blocked in @ref waitEvents.
+  ///
+  /// May be called from any thread. If no thread is waiting, the next wait
+  /// returns straight away.
+  virtual void wake() = 0;
+
+  /// @brief Returns the events that have been polled by the window.
+  ///
+  /// The owner of the window is responsible for handling and then clearing
+  /// the queue once per frame.
+  /// @return The queue of events waiting to be handled.
+  virtual EventQueue& getEventQueue() = 0;
+
   /// @brief Updates the window.
   ///
   /// Called every frame in order to update the window to show what has been
@@ -85,14 +111,6 @@ public:
   /// @return The height of the window.
   virtual uint32_t getHeight() = 0;
 
-  /// @brief Sets a callback to handle @ref Event\ s that occure.
-  ///
-  /// This function alls callbacks to be used which in turn allows for events
-  /// to be handled without the need for polling.
-  /// @param[in] callback The callback function for which will be used on
-  ///                     events handled by the window.
-  virtual void setEventCallback(const EventCallback& callback) = 0;
-
   /// @brief Setter for v-sync.
   ///
   /// An interface used to enable and disable vSync for the window.
@@ -105,6 +123,28 @@ public:
   /// @return True if v-sync is enabled, false otherwise.
   virtual bool isVSync() const = 0;
 
+  /// @brief Setter for raw mouse motion.
+  ///
+  /// Captures and hides the cursor and, where the platform supports it,
+  /// reports mouse motion without any acceleration applied.
+  /// @param[in] enable True to enable raw mouse motion, false to disable it.
+  /// @return true if the mode was changed and false if it is not supported.
+  virtual bool setRawMouseMotion(bool enable) = 0;
+
+  /// @brief Getter for raw mouse motion.
+  ///
+  /// @return True if raw mouse motion is enabled, false otherwise.
+  virtual bool isRawMouseMotion() const = 0;
+
+  /// @brief Queries the OS to see if a specific key is pressed.
+  ///
+  /// This is a call into the OS and should not be used to check input each
+  /// frame, see @ref Input for that.
+  /// @param[in] keycode The key to query.
+  /// @return true if the key is pressed and false if it is not or the key is
+  ///         not known to the OS.
+  virtual bool isKeyPressed(KeyCode keycode) const = 0;
+
   /// @brief Getter for the raw window handler.
   ///
   /// Returns a pointer to the raw window object that is native to the
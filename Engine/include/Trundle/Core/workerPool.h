@@ -0,0 +1,94 @@
+//===-- workerPool.h ------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A fixed set of threads that run batches of independent tasks, with the
+/// calling thread taking part in every batch.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/util.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+//===-- WorkerPool --------------------------------------------------------===//
+/// @brief Runs batches of tasks across a set of threads.
+///
+/// The threads are started once and sleep between batches, so a batch only
+/// costs a wake up rather than creating threads. Tasks are handed out one at
+/// a time from a shared counter, so threads that finish early take the
+/// remaining work.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API WorkerPool {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] workers The number of threads to start, the thread that
+  ///                    calls @ref run also works so a pool of n workers
+  ///                    runs tasks on n + 1 threads.
+  explicit WorkerPool(size_t workers);
+
+  /// @brief Default destructor, waits for the threads to exit.
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /// @brief Runs a task for every index in a batch and waits for them all.
+  ///
+  /// Must only be called from one thread at a time, and not from a task.
+  /// @param[in] count The number of tasks in the batch.
+  /// @param[in] task The function called with the index of each task.
+  void run(size_t count, const std::function<void(size_t)>& task);
+
+  /// @brief Returns the number of threads that run tasks, including the
+  ///        caller of @ref run.
+  size_t size() const;
+
+private:
+  // The loop run by each thread.
+  void work();
+  // Runs tasks from the current batch until there are none left, returning
+  // the number of tasks that were run.
+  size_t drain();
+
+  std::vector<std::thread> threads;
+
+  std::mutex mutex;
+  // Wakes the threads when a batch starts or the pool is stopping.
+  std::condition_variable started;
+  // Wakes the caller of run when the last task of a batch has finished.
+  std::condition_variable finished;
+  // Counts the batches so the threads can tell when a new one has started.
+  uint64_t batch{0};
+  // The number of tasks in the batch that have not finished.
+  size_t remaining{0};
+  // The number of threads that are running tasks, a new batch is only started
+  // once every thread has left the last one.
+  size_t active{0};
+  bool stopping{false};
+
+  // The current batch, only changed while no thread is active.
+  const std::function<void(size_t)>* task{nullptr};
+  size_t count{0};
+  // The index of the next task to hand out.
+  std::atomic<size_t> next{0};
+};
+
+} // namespace Trundle
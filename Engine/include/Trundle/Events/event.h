@@ -23,6 +23,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <Trundle/Core/clock.h>
 #include <Trundle/Core/util.h>
 #include <Trundle/common.h>
 
@@ -38,10 +39,16 @@ enum class EventType {
   MousePress,
   MouseRelease,
   MouseMove,
+  MouseScroll,
   WindowClose,
-  WindowResize
+  WindowResize,
+  Timer,
+  User
 };
 
+/// @brief The number of values in @ref EventType.
+constexpr size_t EventTypeCount = static_cast<size_t>(EventType::User) + 1;
+
 //===-- EventCategory -----------------------------------------------------===//
 /// @brief A bitmask to help check what category events are in.
 //===----------------------------------------------------------------------===//
@@ -49,9 +56,50 @@ enum class EventCategory {
   None = 0,
   KeyEvent = 1 << 0,
   MouseEvent = 1 << 1,
-  WindowEvent = 1 << 2
+  WindowEvent = 1 << 2,
+  TimerEvent = 1 << 3,
+  UserEvent = 1 << 4
 };
 
+/// @brief Combines two sets of event categories.
+constexpr EventCategory operator|(EventCategory lhs, EventCategory rhs) {
+  return static_cast<EventCategory>(static_cast<int>(lhs) |
+                                    static_cast<int>(rhs));
+}
+
+/// @brief Finds the event categories common to two sets.
+constexpr EventCategory operator&(EventCategory lhs, EventCategory rhs) {
+  return static_cast<EventCategory>(static_cast<int>(lhs) &
+                                    static_cast<int>(rhs));
+}
+
+/// @brief Gets the category that a type of event belongs to.
+///
+/// @param[in] type The type of event.
+/// @return The category of the event.
+constexpr EventCategory getEventCategory(EventType type) {
+  switch (type) {
+  case EventType::KeyPress:
+  case EventType::KeyRelease:
+    return EventCategory::KeyEvent;
+  case EventType::MousePress:
+  case EventType::MouseRelease:
+  case EventType::MouseMove:
+  case EventType::MouseScroll:
+    return EventCategory::MouseEvent;
+  case EventType::WindowClose:
+  case EventType::WindowResize:
+    return EventCategory::WindowEvent;
+  case EventType::Timer:
+    return EventCategory::TimerEvent;
+  case EventType::User:
+    return EventCategory::UserEvent;
+  case EventType::None:
+    break;
+  }
+  return EventCategory::None;
+}
+
 //===-- Event -------------------------------------------------------------===//
 /// @brief The abstract event type that all events inherit from.
 //===----------------------------------------------------------------------===//
@@ -89,9 +137,28 @@ public:
   /// @return The type of event that this current object is.
   virtual EventType getEventType() const = 0;
 
+  /// @brief Gets the category that this event belongs to.
+  ///
+  /// @return The category of this event.
+  EventCategory getCategory() const {
+    return getEventCategory(getEventType());
+  }
+
+  /// @brief Checks if this event belongs to any of the given categories.
+  ///
+  /// @param[in] category The categories to check against.
+  /// @return true if the event is in one of the categories, false otherwise.
+  bool isInCategory(EventCategory category) const {
+    return (getCategory() & category) != EventCategory::None;
+  }
+
   /// @brief A flag that signals that the event has been handled.
   bool handled{false};
 
+  /// @brief The time that the event arrived from the operating system, or 0
+  ///        if the event was made by the application.
+  Timestamp timestamp{0};
+
 protected:
   friend class EventDispatch;
 };
@@ -132,6 +199,57 @@ private:
   Event& event;
 };
 
+//===-- EventDispatchTable ------------------------------------------------===//
+/// @brief A table of event handlers indexed by @ref EventType.
+///
+/// Handlers are member functions of Owner that are bound once, ideally in a
+/// constant expression, after which dispatching an event costs a single
+/// indexed indirect call rather than a chain of type checks.
+//===----------------------------------------------------------------------===//
+template <typename Owner>
+class EventDispatchTable {
+public:
+  /// @brief The signature of an entry in the table.
+  using Handler = bool (*)(Owner&, Event&);
+
+  /// @brief Returns a copy of the table with a handler bound for T.
+  ///
+  /// @tparam T The event class that the handler accepts.
+  /// @tparam Func The member function of Owner that handles T.
+  /// @return A new table containing the handler.
+  template <typename T, bool (Owner::*Func)(T&)>
+  constexpr EventDispatchTable bind() const {
+    EventDispatchTable table = *this;
+    table.handlers[static_cast<size_t>(T::getStaticType())] = &call<T, Func>;
+    return table;
+  }
+
+  /// @brief Dispatches an event to the handler bound to its type.
+  ///
+  /// The result of the handler is stored in the handled flag of the event.
+  /// @param[in,out] owner The object to call the handler on.
+  /// @param[in,out] event The event to dispatch.
+  /// @return true if a handler was bound for the event, false otherwise.
+  bool dispatch(Owner& owner, Event& event) const {
+    Handler handler = handlers[static_cast<size_t>(event.getEventType())];
+    if (handler == nullptr) {
+      return false;
+    }
+
+    event.handled = handler(owner, event);
+    return true;
+  }
+
+private:
+  // Restores the concrete type of the event and calls the bound handler.
+  template <typename T, bool (Owner::*Func)(T&)>
+  static bool call(Owner& owner, Event& event) {
+    return (owner.*Func)(static_cast<T&>(event));
+  }
+
+  std::array<Handler, EventTypeCount> handlers{};
+};
+
 /// @brief Overloading the stream operation with osterams to allow events to be
 ///        be printable.
 inline std::ostream& operator<<(std::ostream& os, Event& e) {
@@ -0,0 +1,111 @@
+//===-- eventArena.h ------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A bump allocator for events. Events created by the window callbacks are
+/// placed in a set of reusable memory blocks which are released all at once
+/// at the start of each frame, so that no heap allocation happens per event.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/pointer.h>
+#include <Trundle/Core/util.h>
+#include <Trundle/Events/event.h>
+#include <Trundle/common.h>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace Trundle {
+
+//===-- EventArena --------------------------------------------------------===//
+/// @brief A per-window arena that owns the events created during a frame.
+///
+/// Events are constructed in place inside fixed size blocks of memory and are
+/// all destroyed together by @ref reset. Blocks are never returned to the heap
+/// so once the arena has grown to the busiest frame it has seen, creating an
+/// event costs a pointer bump.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API EventArena {
+public:
+  /// The number of bytes in each block of the arena.
+  static constexpr size_t blockSize = 4096;
+
+  /// @brief Default constructor.
+  EventArena();
+
+  /// @brief Default destructor, destroys any events that are still alive.
+  ~EventArena();
+
+  EventArena(const EventArena&) = delete;
+  EventArena& operator=(const EventArena&) = delete;
+
+  /// @brief Constructs a new event inside of the arena.
+  ///
+  /// The event remains valid until the next call to @ref reset.
+  /// @param[in] args The arguments to forward to the event constructor.
+  /// @return A pointer to the newly constructed event.
+  template <typename T, typename... Args>
+  T* create(Args&&... args) {
+    static_assert(std::is_base_of_v<Event, T>,
+                  "Only events may be allocated in an EventArena");
+    static_assert(sizeof(T) <= blockSize, "Event is larger than a block");
+
+    void* memory = allocate(sizeof(T), alignof(T));
+    T* event = new (memory) T(std::forward<Args>(args)...);
+    events.push_back(event);
+    return event;
+  }
+
+  /// @brief Destroys every event in the arena and recycles the memory.
+  void reset();
+
+  /// @brief Returns an iterator to the oldest event in the arena.
+  std::vector<Event*>::const_iterator begin() const;
+
+  /// @brief Returns an iterator past the newest event in the arena.
+  std::vector<Event*>::const_iterator end() const;
+
+  /// @brief Returns the number of events currently alive in the arena.
+  size_t size() const;
+
+  /// @brief Returns the number of bytes that the arena has reserved.
+  size_t capacity() const;
+
+private:
+  // A single chunk of memory that events are placed in.
+  struct Block {
+    alignas(std::max_align_t) unsigned char data[blockSize];
+  };
+
+  // Finds space for an object of the given size and alignment, adding a new
+  // block only when every existing block is full.
+  void* allocate(size_t size, size_t alignment);
+
+  // The memory owned by the arena.
+  std::vector<Own<Block>> blocks;
+  // The block that is currently being allocated from.
+  size_t currentBlock{0};
+  // The offset of the next free byte in the current block.
+  size_t offset{0};
+  // Every event that is alive, in the order that they were created.
+  std::vector<Event*> events;
+};
+
+} // namespace Trundle
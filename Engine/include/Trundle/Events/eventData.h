@@ -0,0 +1,191 @@
+//===-- eventData.h -------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A value type representation of events. Each kind of event is a small plain
+/// struct and @ref EventData is a tagged union of all of them, so events can
+/// be stored contiguously, copied freely between threads and dispatched with
+/// std::visit instead of virtual calls. The @ref Event class hierarchy is kept
+/// as an adapter on top of this representation.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/util.h>
+#include <Trundle/Events/event.h>
+#include <Trundle/Events/keyEvent.h>
+#include <Trundle/Events/mouseEvent.h>
+#include <Trundle/Events/timerEvent.h>
+#include <Trundle/Events/userEvent.h>
+#include <Trundle/Events/windowEvent.h>
+#include <Trundle/common.h>
+
+#include <type_traits>
+
+namespace Trundle {
+
+/// @brief The data of an empty event, matches @ref EventType::None.
+struct NoneData {};
+
+/// @brief The data of a @ref KeyPressEvent.
+struct KeyPressData {
+  int32_t keyCode{-1};
+  bool repeatEvent{false};
+};
+
+/// @brief The data of a @ref KeyReleaseEvent.
+struct KeyReleaseData {
+  int32_t keyCode{-1};
+};
+
+/// @brief The data of a @ref MousePressEvent.
+struct MousePressData {
+  int32_t mouseCode{-1};
+};
+
+/// @brief The data of a @ref MouseReleaseEvent.
+struct MouseReleaseData {
+  int32_t mouseCode{-1};
+};
+
+/// @brief The data of a @ref MouseMoveEvent.
+struct MouseMoveData {
+  double x{0};
+  double y{0};
+  double dx{0};
+  double dy{0};
+};
+
+/// @brief The data of a @ref MouseScrollEvent.
+struct MouseScrollData {
+  double xOffset{0};
+  double yOffset{0};
+};
+
+/// @brief The data of a @ref WindowCloseEvent.
+struct WindowCloseData {};
+
+/// @brief The data of a @ref WindowResizeEvent.
+struct WindowResizeData {
+  int32_t width{-1};
+  int32_t height{-1};
+};
+
+/// @brief The data of a @ref TimerEvent.
+struct TimerData {
+  TimerHandle handle;
+  uint32_t code{0};
+};
+
+/// @brief The data of a @ref UserEvent.
+struct UserData {
+  uint32_t code{0};
+  uint64_t payload{0};
+};
+
+//===-- EventData ---------------------------------------------------------===//
+/// @brief A tagged union of every kind of event.
+///
+/// The alternatives are listed in the same order as @ref EventType so that the
+/// index of the active alternative is the type of the event.
+//===----------------------------------------------------------------------===//
+using EventData = std::variant<NoneData, KeyPressData, KeyReleaseData,
+                               MousePressData, MouseReleaseData, MouseMoveData,
+                               MouseScrollData, WindowCloseData,
+                               WindowResizeData, TimerData, UserData>;
+
+static_assert(std::is_trivially_copyable_v<EventData>,
+              "EventData must be safe to copy as raw memory");
+static_assert(sizeof(EventData) <= 64,
+              "EventData should fit within a single cache line");
+static_assert(std::variant_size_v<EventData> == EventTypeCount,
+              "EventData must have an alternative for every EventType");
+
+/// @brief Gets the @ref EventType of a value event.
+///
+/// @param[in] data The event to query.
+/// @return The type of the event.
+inline EventType getEventType(const EventData& data) {
+  return static_cast<EventType>(data.index());
+}
+
+/// @brief Converts an @ref Event object into its value representation.
+///
+/// @param[in] event The event to convert.
+/// @return The value representation of the event.
+TRUNDLE_API EventData toEventData(const Event& event);
+
+namespace details {
+
+// Builds the class representation of each value event.
+inline KeyPressEvent makeEvent(const KeyPressData& d) {
+  return KeyPressEvent(d.keyCode, d.repeatEvent);
+}
+inline KeyReleaseEvent makeEvent(const KeyReleaseData& d) {
+  return KeyReleaseEvent(d.keyCode);
+}
+inline MousePressEvent makeEvent(const MousePressData& d) {
+  return MousePressEvent(d.mouseCode);
+}
+inline MouseReleaseEvent makeEvent(const MouseReleaseData& d) {
+  return MouseReleaseEvent(d.mouseCode);
+}
+inline MouseMoveEvent makeEvent(const MouseMoveData& d) {
+  return MouseMoveEvent(d.x, d.y, d.dx, d.dy);
+}
+inline MouseScrollEvent makeEvent(const MouseScrollData& d) {
+  return MouseScrollEvent(d.xOffset, d.yOffset);
+}
+inline WindowCloseEvent makeEvent(const WindowCloseData&) {
+  return WindowCloseEvent();
+}
+inline WindowResizeEvent makeEvent(const WindowResizeData& d) {
+  return WindowResizeEvent(d.width, d.height);
+}
+inline TimerEvent makeEvent(const TimerData& d) {
+  return TimerEvent(d.handle, d.code);
+}
+inline UserEvent makeEvent(const UserData& d) {
+  return UserEvent(d.code, d.payload);
+}
+
+} // namespace details
+
+/// @brief Runs code written against the @ref Event classes on a value event.
+///
+/// A temporary instance of the matching event class is built on the stack and
+/// passed to func, allowing value events to flow through the existing
+/// handlers without any heap allocation.
+/// @param[in] data The event to adapt.
+/// @param[in] func A callable that accepts an @ref Event&.
+/// @return true if the event was handled and false otherwise.
+template <typename Func>
+bool withEvent(const EventData& data, Func&& func) {
+  return std::visit(
+      [&func](const auto& value) -> bool {
+        if constexpr (std::is_same_v<std::decay_t<decltype(value)>, NoneData>) {
+          return false;
+        } else {
+          auto event = details::makeEvent(value);
+          func(static_cast<Event&>(event));
+          return event.handled;
+        }
+      },
+      data);
+}
+
+} // namespace Trundle
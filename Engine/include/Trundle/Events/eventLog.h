@@ -0,0 +1,189 @@
+//===-- eventLog.h --------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A compact binary format for recording events and playing them back. A log
+/// is a small header followed by fixed size records, so it can be written
+/// with a single buffered stream and read straight out of a memory mapped
+/// file.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/mappedFile.h>
+#include <Trundle/Core/util.h>
+#include <Trundle/Events/eventData.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+/// @brief The bytes that every event log starts with.
+constexpr char EventLogMagic[8] = {'T', 'R', 'N', 'D', 'L', 'O', 'G', '\0'};
+
+/// @brief The version of the event log format, bumped whenever the layout of
+///        @ref EventLogHeader, @ref EventRecord or any @ref EventData
+///        alternative changes.
+constexpr uint32_t EventLogVersion = 4;
+
+/// @brief The type of a record that marks an update of the layers rather
+///        than an event. The payload holds the step of the update.
+constexpr uint32_t UpdateRecordType = ~0u;
+
+/// @brief The header at the start of an event log.
+struct EventLogHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+};
+
+/// @brief A single recorded event.
+///
+/// Records are stored in the byte order of the machine that wrote them.
+struct EventRecord {
+  // Nanoseconds since the recording started.
+  uint64_t timestamp;
+  // The frame that the event was handled in.
+  uint64_t frame;
+  // The @ref EventType of the event, or @ref UpdateRecordType.
+  uint32_t type;
+  uint32_t reserved;
+  // The @ref EventData alternative of the event.
+  unsigned char payload[32];
+};
+
+static_assert(sizeof(EventLogHeader) == 16, "EventLogHeader must be packed");
+static_assert(sizeof(EventRecord) == 56, "EventRecord must be packed");
+
+/// @brief Packs an event into a record.
+///
+/// @param[in] event The event to pack.
+/// @param[in] timestamp The time of the event, in nanoseconds.
+/// @param[in] frame The frame that the event was handled in.
+/// @return The packed record.
+TRUNDLE_API EventRecord toEventRecord(const EventData& event,
+                                      uint64_t timestamp, uint64_t frame);
+
+/// @brief Packs an update of the layers into a record.
+///
+/// @param[in] step The step of the update, in nanoseconds.
+/// @param[in] timestamp The time of the update, in nanoseconds.
+/// @param[in] frame The frame that was updated.
+/// @return The packed record.
+TRUNDLE_API EventRecord toUpdateRecord(Timestamp step, uint64_t timestamp,
+                                       uint64_t frame);
+
+/// @brief Gets the step of an update record.
+///
+/// @param[in] record The record, its type must be @ref UpdateRecordType.
+/// @return The step of the update, in nanoseconds.
+TRUNDLE_API Timestamp getUpdateStep(const EventRecord& record);
+
+/// @brief Unpacks the event stored in a record.
+///
+/// @param[in] record The record to unpack.
+/// @return The event, or @ref NoneData if the record is not a known type.
+TRUNDLE_API EventData toEventData(const EventRecord& record);
+
+//===-- EventRecorder -----------------------------------------------------===//
+/// @brief Writes events to an event log.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API EventRecorder {
+public:
+  /// @brief Starts a new log, replacing any file at the path.
+  ///
+  /// @param[in] path The path of the log to write.
+  /// @return true if the log was created and false otherwise.
+  bool open(const std::string& path);
+
+  /// @brief Finishes the log and closes the file.
+  void close();
+
+  /// @brief Checks if a log is being written.
+  ///
+  /// @return true if a log is open, false otherwise.
+  inline bool isOpen() const { return file.is_open(); }
+
+  /// @brief Appends an event to the log.
+  ///
+  /// @param[in] event The event to record.
+  /// @param[in] timestamp The time that the event arrived, it is stored
+  ///                      relative to when the log was opened.
+  /// @param[in] frame The frame that the event was handled in.
+  void record(const EventData& event, Timestamp timestamp, uint64_t frame);
+
+  /// @brief Appends an update of the layers to the log.
+  ///
+  /// @param[in] step The step that the layers were updated with, in
+  ///                 nanoseconds.
+  /// @param[in] frame The frame that was updated.
+  void recordUpdate(Timestamp step, uint64_t frame);
+
+  /// @brief Gets the number of events and updates that have been recorded.
+  ///
+  /// @return The number of records in the current log.
+  inline size_t size() const { return count; }
+
+private:
+  // The log being written.
+  std::ofstream file;
+  // The time that the log was opened.
+  Timestamp start{0};
+  // The number of records written to the log.
+  size_t count{0};
+};
+
+//===-- EventLog ----------------------------------------------------------===//
+/// @brief A read-only view of an event log.
+///
+/// The log is memory mapped, so opening it is cheap and records are only read
+/// from disk as they are accessed.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API EventLog {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] path The path of the log to read.
+  explicit EventLog(const std::string& path);
+
+  /// @brief Checks if the file was opened and is an event log of the current
+  ///        version.
+  ///
+  /// @return true if the log can be read, false otherwise.
+  inline bool isValid() const { return valid; }
+
+  /// @brief Gets the number of records in the log.
+  ///
+  /// @return The number of records.
+  inline size_t size() const { return count; }
+
+  /// @brief Gets a record from the log.
+  ///
+  /// @param[in] index The position of the record, must be less than
+  ///                  @ref size.
+  /// @return The record.
+  EventRecord operator[](size_t index) const;
+
+private:
+  // The mapped contents of the log.
+  MappedFile file;
+  // A flag that is set if the header of the log was accepted.
+  bool valid{false};
+  // The number of complete records in the log.
+  size_t count{0};
+};
+
+} // namespace Trundle
@@ -0,0 +1,127 @@
+//===-- eventQueue.h ------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// A queue of the events that a window has received during a frame. Events are
+/// appended while the OS is polled and the application then handles the whole
+/// frame's worth of input in a single pass.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/util.h>
+#include <Trundle/Events/event.h>
+#include <Trundle/Events/eventArena.h>
+#include <Trundle/Events/mouseEvent.h>
+#include <Trundle/Events/windowEvent.h>
+#include <Trundle/common.h>
+
+#include <type_traits>
+
+namespace Trundle {
+
+//===-- EventQueue --------------------------------------------------------===//
+/// @brief An ordered, per-frame buffer of events.
+///
+/// Events are stored in an @ref EventArena, so they are laid out next to each
+/// other in the order that they arrived and pushing an event does not
+/// allocate once the queue has warmed up.
+///
+/// When coalescing is enabled the @ref MouseMoveEvent\ s,
+/// @ref MouseScrollEvent\ s and @ref WindowResizeEvent\ s between two other
+/// events are folded into one event of each type, holding the latest state
+/// and the accumulated distances, even when the types are interleaved as
+/// they are while dragging a window edge. Any other event, such as a key or
+/// button event, ends the merging, so the order relative to key and button
+/// events is preserved.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API EventQueue {
+public:
+  /// @brief Default constructor.
+  EventQueue();
+
+  /// @brief Default destructor.
+  ~EventQueue();
+
+  /// @brief Constructs a new event at the back of the queue.
+  ///
+  /// The event is stamped with the current time. A coalesced event keeps the
+  /// time of the oldest event merged into it, so latency is always measured
+  /// from the first input that it carries.
+  /// @param[in] args The arguments to forward to the event constructor.
+  /// @return A pointer to the queued event, valid until @ref clear.
+  template <typename T, typename... Args>
+  T* push(Args&&... args) {
+    if constexpr (std::is_same_v<T, MouseMoveEvent> ||
+                  std::is_same_v<T, MouseScrollEvent> ||
+                  std::is_same_v<T, WindowResizeEvent>) {
+      Event*& latestOfType = latest[static_cast<size_t>(T::getStaticType())];
+      if (coalescing && latestOfType != nullptr) {
+        T* merged = static_cast<T*>(latestOfType);
+        merged->coalesce(T(std::forward<Args>(args)...));
+        return merged;
+      }
+      T* event = arena.create<T>(std::forward<Args>(args)...);
+      event->timestamp = getTimestamp();
+      latestOfType = event;
+      return event;
+    } else {
+      T* event = arena.create<T>(std::forward<Args>(args)...);
+      event->timestamp = getTimestamp();
+      // Later events must not be merged into the ones before this.
+      latest.fill(nullptr);
+      return event;
+    }
+  }
+
+  /// @brief Enables or disables coalescing of mouse moves, scrolls and
+  ///        resizes.
+  ///
+  /// @param[in] enable True to enable coalescing, false to disable it.
+  void setCoalescing(bool enable);
+
+  /// @brief Checks if coalescing is enabled.
+  ///
+  /// @return True if coalescing is enabled, false otherwise.
+  bool isCoalescing() const;
+
+  /// @brief Returns an iterator to the oldest event in the queue.
+  std::vector<Event*>::const_iterator begin() const;
+
+  /// @brief Returns an iterator past the newest event in the queue.
+  std::vector<Event*>::const_iterator end() const;
+
+  /// @brief Returns the number of events in the queue.
+  size_t size() const;
+
+  /// @brief Checks if there are no events in the queue.
+  bool empty() const;
+
+  /// @brief Destroys every event in the queue.
+  void clear();
+
+private:
+  // Storage for the queued events.
+  EventArena arena;
+  // The newest event of each type that can still be merged into, indexed by
+  // EventType.
+  std::array<Event*, EventTypeCount> latest{};
+  // A flag for determining if events should be coalesced.
+  bool coalescing{false};
+};
+
+} // namespace Trundle
@@ -72,7 +72,9 @@ public:
   /// @brief A static function to retrieve the @ref EventType of this event.
   ///
   /// @return The type of event this object represents.
-  static EventType getStaticType();
+  static constexpr EventType getStaticType() {
+    return EventType::KeyPress;
+  }
 
   /// @brief A virtual function to retrieve the @ref EventType of this event.
   ///
@@ -95,6 +97,11 @@ public:
   /// @return A string describing this event.
   std::string toString() const override final;
 
+  /// @brief Checks if this event was generated by a key being held down.
+  ///
+  /// @return true if this is a repeated event and false otherwise.
+  bool isRepeatEvent() const;
+
 private:
   bool repeatEvent = false;
 };
@@ -115,7 +122,9 @@ public:
   /// @brief A static function to retrieve the @ref EventType of this event.
   ///
   /// @return The type of event this object represents.
-  static EventType getStaticType();
+  static constexpr EventType getStaticType() {
+    return EventType::KeyRelease;
+  }
 
   /// @brief A virtual function to retrieve the @ref EventType of this event.
   ///
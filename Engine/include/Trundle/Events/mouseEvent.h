@@ -66,7 +66,9 @@ public:
   /// @brief A static function to retrieve the @ref EventType of this event.
   ///
   /// @return The type of event this object represents.
-  static EventType getStaticType();
+  static constexpr EventType getStaticType() {
+    return EventType::MousePress;
+  }
 
   /// @brief A virtual function to retrieve the @ref EventType of this event.
   ///
@@ -106,7 +108,9 @@ public:
   /// @brief A static function to retrieve the @ref EventType of this event.
   ///
   /// @return The type of event this object represents.
-  static EventType getStaticType();
+  static constexpr EventType getStaticType() {
+    return EventType::MouseRelease;
+  }
 
   /// @brief A virtual function to retrieve the @ref EventType of this event.
   ///
@@ -142,12 +146,16 @@ public:
   ///
   /// @param[in] x The x coordinate of where the mouse is now at.
   /// @param[in] y The y coordinate of where the mouse is now at.
-  MouseMoveEvent(double x, double y);
+  /// @param[in] dx The distance moved along x since the last move event.
+  /// @param[in] dy The distance moved along y since the last move event.
+  MouseMoveEvent(double x, double y, double dx = 0, double dy = 0);
 
   /// @brief A static function to retrieve the @ref EventType of this event.
   ///
   /// @return The type of event this object represents.
-  static EventType getStaticType();
+  static constexpr EventType getStaticType() {
+    return EventType::MouseMove;
+  }
 
   /// @brief A virtual function to retrieve the @ref EventType of this event.
   ///
@@ -174,10 +182,83 @@ public:
   /// @return A tuple containing the x and y coordinates.
   std::tuple<double, double> getPosition() const;
 
+  /// @brief Gets the distance that the mouse has moved.
+  ///
+  /// @return A tuple containing the x and y distance.
+  std::tuple<double, double> getDelta() const;
+
+  /// @brief Folds a later mouse move into this event.
+  ///
+  /// The position becomes that of the later event and the distances moved
+  /// are accumulated.
+  /// @param[in] later The mouse move that happened after this one.
+  void coalesce(const MouseMoveEvent& later);
+
 private:
   // Storage for the x and y coordinates of the mouse.
   double x = 0;
   double y = 0;
+  // Storage for the distance moved.
+  double dx = 0;
+  double dy = 0;
+};
+
+//===-- MouseScrollEvent --------------------------------------------------===//
+/// @brief An event that represents when a mouse wheel has been scrolled.
+///
+/// A child class of @ref Event that represents an event when there is
+/// scrolling from a mouse wheel or trackpad.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API MouseScrollEvent : public Event {
+public:
+  /// @brief Default constructor
+  ///
+  /// @param[in] xOffset The distance scrolled along x.
+  /// @param[in] yOffset The distance scrolled along y.
+  MouseScrollEvent(double xOffset, double yOffset);
+
+  /// @brief A static function to retrieve the @ref EventType of this event.
+  ///
+  /// @return The type of event this object represents.
+  static constexpr EventType getStaticType() {
+    return EventType::MouseScroll;
+  }
+
+  /// @brief A virtual function to retrieve the @ref EventType of this event.
+  ///
+  /// This function allows owners of an @ref Event pointer to retrieve the 
+  /// @ref EventType of it.
+  /// @return The type of event this object represents.
+  virtual EventType getEventType() const override final;
+
+  /// @brief A virtual function that returns the name of this @ref Event.
+  ///
+  /// This function allows owners of an @ref Event pointer to retrieve the 
+  /// name of the event.
+  /// @return The event name.
+  virtual const char* getName() const override final;
+
+  /// @brief Gets a string that describes this event.
+  ///
+  /// Returns a string containing the distance that was scrolled.
+  /// @return A string describing this event.
+  virtual std::string toString() const override final;
+
+  /// @brief Gets the distance that was scrolled.
+  ///
+  /// @return A tuple containing the x and y distance.
+  std::tuple<double, double> getOffset() const;
+
+  /// @brief Folds a later scroll into this event.
+  ///
+  /// The distances scrolled are accumulated.
+  /// @param[in] later The scroll that happened after this one.
+  void coalesce(const MouseScrollEvent& later);
+
+private:
+  // Storage for the distance scrolled.
+  double xOffset = 0;
+  double yOffset = 0;
 };
 
 } // namespace Trundle
@@ -0,0 +1,88 @@
+//===-- timerEvent.h ------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// Represents a timer scheduled on the @ref Application firing.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/timerWheel.h>
+#include <Trundle/Events/event.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+//===-- TimerEvent --------------------------------------------------------===//
+/// @brief An event that is sent when a timer fires.
+///
+/// The engine does not handle timer events itself, they are passed straight to
+/// the layers. The handle identifies the timer that fired and the code is the
+/// value that it was scheduled with.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API TimerEvent : public Event {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] handle The timer that fired.
+  /// @param[in] code The application defined code of the timer.
+  TimerEvent(TimerHandle handle, uint32_t code);
+
+  /// @brief A static function to retrieve the @ref EventType of this event.
+  ///
+  /// @return The type of event this object represents.
+  static constexpr EventType getStaticType() {
+    return EventType::Timer;
+  }
+
+  /// @brief A virtual function to retrieve the @ref EventType of this event.
+  ///
+  /// This function allows owners of an @ref Event pointer to retrieve the 
+  /// @ref EventType of it.
+  /// @return The type of event this object represents.
+  virtual EventType getEventType() const override final;
+
+  /// @brief A virtual function that returns the name of this @ref Event.
+  ///
+  /// This function allows owners of an @ref Event pointer to retrieve the 
+  /// name of the event.
+  /// @return The event name.
+  virtual const char* getName() const override final;
+
+  /// @brief Gets a string that describes this event.
+  ///
+  /// Returns a string containing the timer and code of the event.
+  /// @return A string describing this event.
+  std::string toString() const override final;
+
+  /// @brief A public getter for the timer that fired.
+  ///
+  /// @return The handle of the timer.
+  TimerHandle getHandle() const;
+
+  /// @brief A public getter for the application defined code.
+  ///
+  /// @return The code of the timer.
+  uint32_t getCode() const;
+
+private:
+  // Storage for the handle and code.
+  TimerHandle handle;
+  uint32_t code{0};
+};
+
+} // namespace Trundle
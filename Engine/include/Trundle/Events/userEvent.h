@@ -0,0 +1,88 @@
+//===-- userEvent.h -------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// Represents events that are defined by the application rather than the OS,
+/// for example a worker thread announcing that an asset has been loaded.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Events/event.h>
+#include <Trundle/common.h>
+
+namespace Trundle {
+
+//===-- UserEvent ---------------------------------------------------------===//
+/// @brief An event whose meaning is defined by the application.
+///
+/// The engine does not handle user events itself, they are passed straight to
+/// the layers. The code identifies what happened and the payload carries a
+/// single value such as a handle or an index.
+//===----------------------------------------------------------------------===//
+class TRUNDLE_API UserEvent : public Event {
+public:
+  /// @brief Default constructor.
+  ///
+  /// @param[in] code An application defined code for the event.
+  /// @param[in] payload An application defined value for the event.
+  UserEvent(uint32_t code, uint64_t payload = 0);
+
+  /// @brief A static function to retrieve the @ref EventType of this event.
+  ///
+  /// @return The type of event this object represents.
+  static constexpr EventType getStaticType() {
+    return EventType::User;
+  }
+
+  /// @brief A virtual function to retrieve the @ref EventType of this event.
+  ///
+  /// This function allows owners of an @ref Event pointer to retrieve the 
+  /// @ref EventType of it.
+  /// @return The type of event this object represents.
+  virtual EventType getEventType() const override final;
+
+  /// @brief A virtual function that returns the name of this @ref Event.
+  ///
+  /// This function allows owners of an @ref Event pointer to retrieve the 
+  /// name of the event.
+  /// @return The event name.
+  virtual const char* getName() const override final;
+
+  /// @brief Gets a string that describes this event.
+  ///
+  /// Returns a string containing the code and payload of the event.
+  /// @return A string describing this event.
+  std::string toString() const override final;
+
+  /// @brief A public getter for the application defined code.
+  ///
+  /// @return The code of the event.
+  uint32_t getCode() const;
+
+  /// @brief A public getter for the application defined payload.
+  ///
+  /// @return The payload of the event.
+  uint64_t getPayload() const;
+
+private:
+  // Storage for the code and payload.
+  uint32_t code{0};
+  uint64_t payload{0};
+};
+
+} // namespace Trundle
@@ -40,7 +40,9 @@ public:
   /// @brief A static function to retrieve the @ref EventType of this event.
   ///
   /// @return The type of event this object represents.
-  static EventType getStaticType();
+  static constexpr EventType getStaticType() {
+    return EventType::WindowClose;
+  }
 
   /// @brief A virtual function to retrieve the @ref EventType of this event.
   ///
@@ -79,7 +81,9 @@ public:
   /// @brief A static function to retrieve the @ref EventType of this event.
   ///
   /// @return The type of event this object represents.
-  static EventType getStaticType();
+  static constexpr EventType getStaticType() {
+    return EventType::WindowResize;
+  }
 
   /// @brief A virtual function to retrieve the @ref EventType of this event.
   ///
@@ -101,6 +105,16 @@ public:
   /// @return A string describing this event.
   std::string toString() const override final;
 
+  /// @brief Gets the new width and height of the window.
+  ///
+  /// @return A tuple containing the width and height.
+  std::tuple<int, int> getSize() const;
+
+  /// @brief Folds a later resize into this event.
+  ///
+  /// @param[in] later The resize that happened after this one.
+  void coalesce(const WindowResizeEvent& later);
+
 private:
   // Storage for the width and height.
   int width{-1};
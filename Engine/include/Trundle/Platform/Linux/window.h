@@ -22,6 +22,7 @@
 #pragma once
 
 #include <Trundle/Core/window.h>
+#include <Trundle/Events/eventQueue.h>
 #include <GLFW/glfw3.h>
 
 namespace Trundle {
@@ -42,6 +43,25 @@ public:
   /// @brief Default virtual destructor.
   virtual ~LinuxWindow();
 
+  /// @brief Polls the OS for events.
+  ///
+  /// Any events that have occured since the last poll are appended to the
+  /// window's @ref EventQueue.
+  void pollEvents() override final;
+
+  /// @brief Waits for the OS to send an event, then polls for events.
+  ///
+  /// @param[in] timeout The longest time to wait, in nanoseconds.
+  void waitEvents(Timestamp timeout) override final;
+
+  /// @brief Wakes a thread that is blocked in @ref waitEvents.
+  void wake() override final;
+
+  /// @brief Returns the events that have been polled by the window.
+  ///
+  /// @return The queue of events waiting to be handled.
+  EventQueue& getEventQueue() override final;
+
   /// @brief Updates the window.
   ///
   /// Called every frame in order to update the window to show what has been
@@ -60,14 +80,6 @@ public:
   /// @return The height of the window.
   uint32_t getHeight() override final;
 
-  /// @brief Sets a callback to handle @ref Event\ s that occure.
-  ///
-  /// This function alls callbacks to be used which in turn allows for events
-  /// to be handled without the need for polling.
-  /// @param[in] callback The callback function for which will be used on
-  ///                     events handled by the window.
-  virtual void setEventCallback(const EventCallback& callback) override final;
-
   /// @brief Setter for v-sync.
   ///
   /// An interface used to enable and disable vSync for the window.
@@ -80,6 +92,26 @@ public:
   /// @return True if v-sync is enabled, false otherwise.
   bool isVSync() const override final;
 
+  /// @brief Setter for raw mouse motion.
+  ///
+  /// Captures and hides the cursor and, where the platform supports it,
+  /// reports mouse motion without any acceleration applied.
+  /// @param[in] enable True to enable raw mouse motion, false to disable it.
+  /// @return true if the mode was changed and false if it is not supported.
+  bool setRawMouseMotion(bool enable) override final;
+
+  /// @brief Getter for raw mouse motion.
+  ///
+  /// @return True if raw mouse motion is enabled, false otherwise.
+  bool isRawMouseMotion() const override final;
+
+  /// @brief Queries the OS to see if a specific key is pressed.
+  ///
+  /// @param[in] keycode The key to query.
+  /// @return true if the key is pressed and false if it is not or the key is
+  ///         not known to GLFW.
+  bool isKeyPressed(KeyCode keycode) const override final;
+
   /// @brief Getter for the raw window handler.
   ///
   /// Returns a pointer to the raw window object that is native to the
@@ -101,16 +133,20 @@ private:
     std::string title;
     uint32_t width, height;
     bool vSync;
+    bool rawMouseMotion{false};
+
+    // The last known cursor position, used to find how far the mouse moved.
+    double cursorX{0}, cursorY{0};
+    bool cursorTracked{false};
 
-    EventCallback callback;
+    // The events received by the callbacks since they were last handled.
+    EventQueue events;
   };
 
   // The window's user pointer
   WindowData data;
   // A raw pointer to the windows
   GLFWwindow* window;
-  // The event handler callback.
-  EventCallback callback;
 };
 
 } // namespace Trundle
@@ -0,0 +1,44 @@
+//===-- gamepad.h ---------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// The MacOS implementation for reading gamepads.
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <Trundle/Core/gamepad.h>
+
+namespace Trundle {
+
+//===-- MacOSGamepadSource ------------------------------------------------===//
+/// @brief A source that reads the gamepads known to GLFW on MacOS.
+///
+/// Only joysticks that GLFW has a gamepad mapping for are reported, so every
+/// connected gamepad has the same layout of buttons and axes.
+//===----------------------------------------------------------------------===//
+class MacOSGamepadSource : public GamepadSource {
+public:
+  /// @brief Reads the state of a gamepad.
+  ///
+  /// @param[in] id The gamepad to read, less than @ref GamepadCount.
+  /// @param[out] state Set to the state of the gamepad if it is connected.
+  /// @return true if the gamepad is connected and false otherwise.
+  bool read(size_t id, GamepadState& state) override final;
+};
+
+} // namespace Trundle
@@ -23,501 +23,207 @@
 
 #include <Trundle/Core/keyCode.h>
 #include <Trundle/Core/util.h>
+#include <Trundle/common.h>
 
 #include <GL/gl3w.h>
 #include <GLFW/glfw3.h>
 
 namespace Trundle {
 
-/// @brief Converts Trundles key codes to GLFWs key codes.
-inline int TrundleToGL(KeyCode key) {
-  switch (key) {
-  case KeyCode::None:
-    return GLFW_KEY_UNKNOWN;
-
-  case KeyCode::Backspace:
-  case KeyCode::Delete:
-  case KeyCode::Tab:
-  case KeyCode::Clear:
-  case KeyCode::Return:
-  case KeyCode::Pause:
-    assert(0 && "Error: Unhandled keycode.");
-    return 0;
-
-  case KeyCode::Escape:
-    return GLFW_KEY_ESCAPE;
-  case KeyCode::Space:
-    return GLFW_KEY_SPACE;
-
-  case KeyCode::Keypad0:
-  case KeyCode::Keypad1:
-  case KeyCode::Keypad2:
-  case KeyCode::Keypad3:
-  case KeyCode::Keypad4:
-  case KeyCode::Keypad5:
-  case KeyCode::Keypad6:
-  case KeyCode::Keypad7:
-  case KeyCode::Keypad8:
-  case KeyCode::Keypad9:
-  case KeyCode::KeypadPeriod:
-  case KeyCode::KeypadSlash:
-  case KeyCode::KeypadAsterisk:
-  case KeyCode::KeypadMinus:
-  case KeyCode::KeypadPlus:
-  case KeyCode::KeypadEnter:
-  case KeyCode::KeypadEqual:
-    assert(0 && "Error: Unhandled keycode.");
-    return 0;
-
-  case KeyCode::Up:
-    return GLFW_KEY_UP;
-  case KeyCode::Down:
-    return GLFW_KEY_DOWN;
-  case KeyCode::Left:
-    return GLFW_KEY_LEFT;
-  case KeyCode::Right:
-    return GLFW_KEY_RIGHT;
-
-  case KeyCode::Insert:
-  case KeyCode::Home:
-  case KeyCode::End:
-  case KeyCode::PageUp:
-  case KeyCode::PageDown:
-  case KeyCode::F1:
-  case KeyCode::F2:
-  case KeyCode::F3:
-  case KeyCode::F4:
-  case KeyCode::F5:
-  case KeyCode::F6:
-  case KeyCode::F7:
-  case KeyCode::F8:
-  case KeyCode::F9:
-  case KeyCode::F10:
-  case KeyCode::F11:
-  case KeyCode::F12:
-  case KeyCode::F13:
-  case KeyCode::F14:
-  case KeyCode::F15:
-    assert(0 && "Error: Unhandled keycode.");
-    return 0;
+namespace details {
+
+// A pair of equivalent Trundle and GLFW key codes.
+struct KeyMapping {
+  KeyCode key;
+  int glfwKey;
+};
+
+// The single definition of how Trundle keys map to GLFW keys, both lookup
+// tables are generated from it. Several Trundle keys name the same physical
+// key (for example LeftCommand and LeftWindows), in which case GLFW keys map
+// back to the first one listed. Keys with no GLFW equivalent, such as shifted
+// symbols, mouse and joystick buttons, are left out.
+constexpr KeyMapping KeyMappings[] = {
+    {KeyCode::Backspace, GLFW_KEY_BACKSPACE},
+    {KeyCode::Delete, GLFW_KEY_DELETE},
+    {KeyCode::Tab, GLFW_KEY_TAB},
+    {KeyCode::Return, GLFW_KEY_ENTER},
+    {KeyCode::Pause, GLFW_KEY_PAUSE},
+    {KeyCode::Escape, GLFW_KEY_ESCAPE},
+    {KeyCode::Space, GLFW_KEY_SPACE},
+    {KeyCode::Keypad0, GLFW_KEY_KP_0},
+    {KeyCode::Keypad1, GLFW_KEY_KP_1},
+    {KeyCode::Keypad2, GLFW_KEY_KP_2},
+    {KeyCode::Keypad3, GLFW_KEY_KP_3},
+    {KeyCode::Keypad4, GLFW_KEY_KP_4},
+    {KeyCode::Keypad5, GLFW_KEY_KP_5},
+    {KeyCode::Keypad6, GLFW_KEY_KP_6},
+    {KeyCode::Keypad7, GLFW_KEY_KP_7},
+    {KeyCode::Keypad8, GLFW_KEY_KP_8},
+    {KeyCode::Keypad9, GLFW_KEY_KP_9},
+    {KeyCode::KeypadPeriod, GLFW_KEY_KP_DECIMAL},
+    {KeyCode::KeypadSlash, GLFW_KEY_KP_DIVIDE},
+    {KeyCode::KeypadAsterisk, GLFW_KEY_KP_MULTIPLY},
+    {KeyCode::KeypadMinus, GLFW_KEY_KP_SUBTRACT},
+    {KeyCode::KeypadPlus, GLFW_KEY_KP_ADD},
+    {KeyCode::KeypadEnter, GLFW_KEY_KP_ENTER},
+    {KeyCode::KeypadEqual, GLFW_KEY_KP_EQUAL},
+    {KeyCode::Up, GLFW_KEY_UP},
+    {KeyCode::Down, GLFW_KEY_DOWN},
+    {KeyCode::Left, GLFW_KEY_LEFT},
+    {KeyCode::Right, GLFW_KEY_RIGHT},
+    {KeyCode::Insert, GLFW_KEY_INSERT},
+    {KeyCode::Home, GLFW_KEY_HOME},
+    {KeyCode::End, GLFW_KEY_END},
+    {KeyCode::PageUp, GLFW_KEY_PAGE_UP},
+    {KeyCode::PageDown, GLFW_KEY_PAGE_DOWN},
+    {KeyCode::F1, GLFW_KEY_F1},
+    {KeyCode::F2, GLFW_KEY_F2},
+    {KeyCode::F3, GLFW_KEY_F3},
+    {KeyCode::F4, GLFW_KEY_F4},
+    {KeyCode::F5, GLFW_KEY_F5},
+    {KeyCode::F6, GLFW_KEY_F6},
+    {KeyCode::F7, GLFW_KEY_F7},
+    {KeyCode::F8, GLFW_KEY_F8},
+    {KeyCode::F9, GLFW_KEY_F9},
+    {KeyCode::F10, GLFW_KEY_F10},
+    {KeyCode::F11, GLFW_KEY_F11},
+    {KeyCode::F12, GLFW_KEY_F12},
+    {KeyCode::F13, GLFW_KEY_F13},
+    {KeyCode::F14, GLFW_KEY_F14},
+    {KeyCode::F15, GLFW_KEY_F15},
+    {KeyCode::Alpha0, GLFW_KEY_0},
+    {KeyCode::Alpha1, GLFW_KEY_1},
+    {KeyCode::Alpha2, GLFW_KEY_2},
+    {KeyCode::Alpha3, GLFW_KEY_3},
+    {KeyCode::Alpha4, GLFW_KEY_4},
+    {KeyCode::Alpha5, GLFW_KEY_5},
+    {KeyCode::Alpha6, GLFW_KEY_6},
+    {KeyCode::Alpha7, GLFW_KEY_7},
+    {KeyCode::Alpha8, GLFW_KEY_8},
+    {KeyCode::Alpha9, GLFW_KEY_9},
+    {KeyCode::Quote, GLFW_KEY_APOSTROPHE},
+    {KeyCode::Comma, GLFW_KEY_COMMA},
+    {KeyCode::Minus, GLFW_KEY_MINUS},
+    {KeyCode::Period, GLFW_KEY_PERIOD},
+    {KeyCode::Slash, GLFW_KEY_SLASH},
+    {KeyCode::Semicolon, GLFW_KEY_SEMICOLON},
+    {KeyCode::Equal, GLFW_KEY_EQUAL},
+    {KeyCode::LeftBracket, GLFW_KEY_LEFT_BRACKET},
+    {KeyCode::Backslash, GLFW_KEY_BACKSLASH},
+    {KeyCode::RightBracket, GLFW_KEY_RIGHT_BRACKET},
+    {KeyCode::BackQuote, GLFW_KEY_GRAVE_ACCENT},
+    {KeyCode::A, GLFW_KEY_A},
+    {KeyCode::B, GLFW_KEY_B},
+    {KeyCode::C, GLFW_KEY_C},
+    {KeyCode::D, GLFW_KEY_D},
+    {KeyCode::E, GLFW_KEY_E},
+    {KeyCode::F, GLFW_KEY_F},
+    {KeyCode::G, GLFW_KEY_G},
+    {KeyCode::H, GLFW_KEY_H},
+    {KeyCode::I, GLFW_KEY_I},
+    {KeyCode::J, GLFW_KEY_J},
+    {KeyCode::K, GLFW_KEY_K},
+    {KeyCode::L, GLFW_KEY_L},
+    {KeyCode::M, GLFW_KEY_M},
+    {KeyCode::N, GLFW_KEY_N},
+    {KeyCode::O, GLFW_KEY_O},
+    {KeyCode::P, GLFW_KEY_P},
+    {KeyCode::Q, GLFW_KEY_Q},
+    {KeyCode::R, GLFW_KEY_R},
+    {KeyCode::S, GLFW_KEY_S},
+    {KeyCode::T, GLFW_KEY_T},
+    {KeyCode::U, GLFW_KEY_U},
+    {KeyCode::V, GLFW_KEY_V},
+    {KeyCode::W, GLFW_KEY_W},
+    {KeyCode::X, GLFW_KEY_X},
+    {KeyCode::Y, GLFW_KEY_Y},
+    {KeyCode::Z, GLFW_KEY_Z},
+    {KeyCode::Numlock, GLFW_KEY_NUM_LOCK},
+    {KeyCode::CapsLock, GLFW_KEY_CAPS_LOCK},
+    {KeyCode::ScrollLock, GLFW_KEY_SCROLL_LOCK},
+    {KeyCode::RightShift, GLFW_KEY_RIGHT_SHIFT},
+    {KeyCode::LeftShift, GLFW_KEY_LEFT_SHIFT},
+    {KeyCode::RightControl, GLFW_KEY_RIGHT_CONTROL},
+    {KeyCode::LeftControl, GLFW_KEY_LEFT_CONTROL},
+    {KeyCode::RightAlt, GLFW_KEY_RIGHT_ALT},
+    {KeyCode::LeftAlt, GLFW_KEY_LEFT_ALT},
+    {KeyCode::LeftCommand, GLFW_KEY_LEFT_SUPER},
+    {KeyCode::LeftApple, GLFW_KEY_LEFT_SUPER},
+    {KeyCode::LeftWindows, GLFW_KEY_LEFT_SUPER},
+    {KeyCode::RightCommand, GLFW_KEY_RIGHT_SUPER},
+    {KeyCode::RightApple, GLFW_KEY_RIGHT_SUPER},
+    {KeyCode::RightWindows, GLFW_KEY_RIGHT_SUPER},
+    {KeyCode::Print, GLFW_KEY_PRINT_SCREEN},
+    {KeyCode::Menu, GLFW_KEY_MENU},
+};
+
+// The number of entries in the GLFW to Trundle table.
+constexpr size_t GLKeyCount = GLFW_KEY_LAST + 1;
+
+constexpr std::array<int, KeyCodeCount> makeTrundleToGLTable() {
+  std::array<int, KeyCodeCount> table{};
+  for (auto& entry : table) {
+    entry = GLFW_KEY_UNKNOWN;
+  }
+  for (const auto& mapping : KeyMappings) {
+    table[static_cast<size_t>(mapping.key)] = mapping.glfwKey;
+  }
+  return table;
+}
 
-  case KeyCode::Alpha0:
-    return GLFW_KEY_0;
-  case KeyCode::Alpha1:
-    return GLFW_KEY_1;
-  case KeyCode::Alpha2:
-    return GLFW_KEY_2;
-  case KeyCode::Alpha3:
-    return GLFW_KEY_3;
-  case KeyCode::Alpha4:
-    return GLFW_KEY_4;
-  case KeyCode::Alpha5:
-    return GLFW_KEY_5;
-  case KeyCode::Alpha6:
-    return GLFW_KEY_6;
-  case KeyCode::Alpha7:
-    return GLFW_KEY_7;
-  case KeyCode::Alpha8:
-    return GLFW_KEY_8;
-  case KeyCode::Alpha9:
-    return GLFW_KEY_9;
+constexpr std::array<KeyCode, GLKeyCount> makeGLToTrundleTable() {
+  std::array<KeyCode, GLKeyCount> table{};
+  for (auto& entry : table) {
+    entry = KeyCode::None;
+  }
+  // Walk backwards so that the first alias of a key is the one kept.
+  for (size_t i = std::size(KeyMappings); i > 0; --i) {
+    const auto& mapping = KeyMappings[i - 1];
+    table[static_cast<size_t>(mapping.glfwKey)] = mapping.key;
+  }
+  return table;
+}
 
-  case KeyCode::Exclaim:
-  case KeyCode::DoubleQuote:
-  case KeyCode::Pound:
-  case KeyCode::Dollar:
-  case KeyCode::Percent:
-  case KeyCode::Ampersand:
-  case KeyCode::Quote:
-  case KeyCode::LeftParen:
-  case KeyCode::RightParen:
-  case KeyCode::Asterisk:
-  case KeyCode::Plus:
-  case KeyCode::Comma:
-  case KeyCode::Minus:
-  case KeyCode::Period:
-  case KeyCode::Slash:
-  case KeyCode::Colon:
-  case KeyCode::Semicolon:
-  case KeyCode::Less:
-  case KeyCode::Equal:
-  case KeyCode::Greater:
-  case KeyCode::Question:
-  case KeyCode::At:
-  case KeyCode::LeftBracket:
-  case KeyCode::Backslash:
-  case KeyCode::RightBracket:
-  case KeyCode::Caret:
-  case KeyCode::Underscore:
-  case KeyCode::BackQuote:
-    assert(0 && "Error: Unhandled keycode.");
-    return 0;
+// Dense lookup tables indexed by the key code being converted.
+constexpr std::array<int, KeyCodeCount> TrundleToGLTable =
+    makeTrundleToGLTable();
+constexpr std::array<KeyCode, GLKeyCount> GLToTrundleTable =
+    makeGLToTrundleTable();
+
+// Checks that every mapped key survives a round trip through both tables.
+constexpr bool isRoundTrip() {
+  for (const auto& mapping : KeyMappings) {
+    KeyCode key = GLToTrundleTable[static_cast<size_t>(mapping.glfwKey)];
+    if (TrundleToGLTable[static_cast<size_t>(key)] != mapping.glfwKey) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  case KeyCode::A:
-    return GLFW_KEY_A;
-  case KeyCode::B:
-    return GLFW_KEY_B;
-  case KeyCode::C:
-    return GLFW_KEY_C;
-  case KeyCode::D:
-    return GLFW_KEY_D;
-  case KeyCode::E:
-    return GLFW_KEY_E;
-  case KeyCode::F:
-    return GLFW_KEY_F;
-  case KeyCode::G:
-    return GLFW_KEY_G;
-  case KeyCode::H:
-    return GLFW_KEY_H;
-  case KeyCode::I:
-    return GLFW_KEY_I;
-  case KeyCode::J:
-    return GLFW_KEY_J;
-  case KeyCode::K:
-    return GLFW_KEY_K;
-  case KeyCode::L:
-    return GLFW_KEY_L;
-  case KeyCode::M:
-    return GLFW_KEY_M;
-  case KeyCode::N:
-    return GLFW_KEY_N;
-  case KeyCode::O:
-    return GLFW_KEY_O;
-  case KeyCode::P:
-    return GLFW_KEY_P;
-  case KeyCode::Q:
-    return GLFW_KEY_Q;
-  case KeyCode::R:
-    return GLFW_KEY_R;
-  case KeyCode::S:
-    return GLFW_KEY_S;
-  case KeyCode::T:
-    return GLFW_KEY_T;
-  case KeyCode::U:
-    return GLFW_KEY_U;
-  case KeyCode::V:
-    return GLFW_KEY_V;
-  case KeyCode::W:
-    return GLFW_KEY_W;
-  case KeyCode::X:
-    return GLFW_KEY_X;
-  case KeyCode::Y:
-    return GLFW_KEY_Y;
-  case KeyCode::Z:
-    return GLFW_KEY_Z;
+static_assert(isRoundTrip(), "Key mappings must convert in both directions");
 
-  case KeyCode::LeftCurlyBracket:
-  case KeyCode::Pipe:
-  case KeyCode::RightCurlyBracket:
-  case KeyCode::Tilde:
-  case KeyCode::Numlock:
-  case KeyCode::CapsLock:
-  case KeyCode::ScrollLock:
-  case KeyCode::RightShift:
-  case KeyCode::LeftShift:
-  case KeyCode::RightControl:
-  case KeyCode::LeftControl:
-  case KeyCode::RightAlt:
-  case KeyCode::LeftAlt:
-  case KeyCode::LeftCommand:
-  case KeyCode::LeftApple:
-  case KeyCode::LeftWindows:
-  case KeyCode::RightCommand:
-  case KeyCode::RightApple:
-  case KeyCode::RightWindows:
-  case KeyCode::AltGr:
-  case KeyCode::Help:
-  case KeyCode::Print:
-  case KeyCode::SysReq:
-  case KeyCode::Break:
-  case KeyCode::Menu:
-  case KeyCode::Mouse0:
-  case KeyCode::Mouse1:
-  case KeyCode::Mouse2:
-  case KeyCode::Mouse3:
-  case KeyCode::Mouse4:
-  case KeyCode::Mouse5:
-  case KeyCode::Mouse6:
-  case KeyCode::JoystickButton0:
-  case KeyCode::JoystickButton1:
-  case KeyCode::JoystickButton2:
-  case KeyCode::JoystickButton3:
-  case KeyCode::JoystickButton4:
-  case KeyCode::JoystickButton5:
-  case KeyCode::JoystickButton6:
-  case KeyCode::JoystickButton7:
-  case KeyCode::JoystickButton8:
-  case KeyCode::JoystickButton9:
-  case KeyCode::JoystickButton10:
-  case KeyCode::JoystickButton11:
-  case KeyCode::JoystickButton12:
-  case KeyCode::JoystickButton13:
-  case KeyCode::JoystickButton14:
-  case KeyCode::JoystickButton15:
-  case KeyCode::JoystickButton16:
-  case KeyCode::JoystickButton17:
-  case KeyCode::JoystickButton18:
-  case KeyCode::JoystickButton19:
-  case KeyCode::Joystick1Button0:
-  case KeyCode::Joystick1Button1:
-  case KeyCode::Joystick1Button2:
-  case KeyCode::Joystick1Button3:
-  case KeyCode::Joystick1Button4:
-  case KeyCode::Joystick1Button5:
-  case KeyCode::Joystick1Button6:
-  case KeyCode::Joystick1Button7:
-  case KeyCode::Joystick1Button8:
-  case KeyCode::Joystick1Button9:
-  case KeyCode::Joystick1Button10:
-  case KeyCode::Joystick1Button11:
-  case KeyCode::Joystick1Button12:
-  case KeyCode::Joystick1Button13:
-  case KeyCode::Joystick1Button14:
-  case KeyCode::Joystick1Button15:
-  case KeyCode::Joystick1Button16:
-  case KeyCode::Joystick1Button17:
-  case KeyCode::Joystick1Button18:
-  case KeyCode::Joystick1Button19:
-  case KeyCode::Joystick2Button0:
-  case KeyCode::Joystick2Button1:
-  case KeyCode::Joystick2Button2:
-  case KeyCode::Joystick2Button3:
-  case KeyCode::Joystick2Button4:
-  case KeyCode::Joystick2Button5:
-  case KeyCode::Joystick2Button6:
-  case KeyCode::Joystick2Button7:
-  case KeyCode::Joystick2Button8:
-  case KeyCode::Joystick2Button9:
-  case KeyCode::Joystick2Button10:
-  case KeyCode::Joystick2Button11:
-  case KeyCode::Joystick2Button12:
-  case KeyCode::Joystick2Button13:
-  case KeyCode::Joystick2Button14:
-  case KeyCode::Joystick2Button15:
-  case KeyCode::Joystick2Button16:
-  case KeyCode::Joystick2Button17:
-  case KeyCode::Joystick2Button18:
-  case KeyCode::Joystick2Button19:
-  case KeyCode::Joystick3Button0:
-  case KeyCode::Joystick3Button1:
-  case KeyCode::Joystick3Button2:
-  case KeyCode::Joystick3Button3:
-  case KeyCode::Joystick3Button4:
-  case KeyCode::Joystick3Button5:
-  case KeyCode::Joystick3Button6:
-  case KeyCode::Joystick3Button7:
-  case KeyCode::Joystick3Button8:
-  case KeyCode::Joystick3Button9:
-  case KeyCode::Joystick3Button10:
-  case KeyCode::Joystick3Button11:
-  case KeyCode::Joystick3Button12:
-  case KeyCode::Joystick3Button13:
-  case KeyCode::Joystick3Button14:
-  case KeyCode::Joystick3Button15:
-  case KeyCode::Joystick3Button16:
-  case KeyCode::Joystick3Button17:
-  case KeyCode::Joystick3Button18:
-  case KeyCode::Joystick3Button19:
-  case KeyCode::Joystick4Button0:
-  case KeyCode::Joystick4Button1:
-  case KeyCode::Joystick4Button2:
-  case KeyCode::Joystick4Button3:
-  case KeyCode::Joystick4Button4:
-  case KeyCode::Joystick4Button5:
-  case KeyCode::Joystick4Button6:
-  case KeyCode::Joystick4Button7:
-  case KeyCode::Joystick4Button8:
-  case KeyCode::Joystick4Button9:
-  case KeyCode::Joystick4Button10:
-  case KeyCode::Joystick4Button11:
-  case KeyCode::Joystick4Button12:
-  case KeyCode::Joystick4Button13:
-  case KeyCode::Joystick4Button14:
-  case KeyCode::Joystick4Button15:
-  case KeyCode::Joystick4Button16:
-  case KeyCode::Joystick4Button17:
-  case KeyCode::Joystick4Button18:
-  case KeyCode::Joystick4Button19:
-  case KeyCode::Joystick5Button0:
-  case KeyCode::Joystick5Button1:
-  case KeyCode::Joystick5Button2:
-  case KeyCode::Joystick5Button3:
-  case KeyCode::Joystick5Button4:
-  case KeyCode::Joystick5Button5:
-  case KeyCode::Joystick5Button6:
-  case KeyCode::Joystick5Button7:
-  case KeyCode::Joystick5Button8:
-  case KeyCode::Joystick5Button9:
-  case KeyCode::Joystick5Button10:
-  case KeyCode::Joystick5Button11:
-  case KeyCode::Joystick5Button12:
-  case KeyCode::Joystick5Button13:
-  case KeyCode::Joystick5Button14:
-  case KeyCode::Joystick5Button15:
-  case KeyCode::Joystick5Button16:
-  case KeyCode::Joystick5Button17:
-  case KeyCode::Joystick5Button18:
-  case KeyCode::Joystick5Button19:
-  case KeyCode::Joystick6Button0:
-  case KeyCode::Joystick6Button1:
-  case KeyCode::Joystick6Button2:
-  case KeyCode::Joystick6Button3:
-  case KeyCode::Joystick6Button4:
-  case KeyCode::Joystick6Button5:
-  case KeyCode::Joystick6Button6:
-  case KeyCode::Joystick6Button7:
-  case KeyCode::Joystick6Button8:
-  case KeyCode::Joystick6Button9:
-  case KeyCode::Joystick6Button10:
-  case KeyCode::Joystick6Button11:
-  case KeyCode::Joystick6Button12:
-  case KeyCode::Joystick6Button13:
-  case KeyCode::Joystick6Button14:
-  case KeyCode::Joystick6Button15:
-  case KeyCode::Joystick6Button16:
-  case KeyCode::Joystick6Button17:
-  case KeyCode::Joystick6Button18:
-  case KeyCode::Joystick6Button19:
-  case KeyCode::Joystick7Button0:
-  case KeyCode::Joystick7Button1:
-  case KeyCode::Joystick7Button2:
-  case KeyCode::Joystick7Button3:
-  case KeyCode::Joystick7Button4:
-  case KeyCode::Joystick7Button5:
-  case KeyCode::Joystick7Button6:
-  case KeyCode::Joystick7Button7:
-  case KeyCode::Joystick7Button8:
-  case KeyCode::Joystick7Button9:
-  case KeyCode::Joystick7Button10:
-  case KeyCode::Joystick7Button11:
-  case KeyCode::Joystick7Button12:
-  case KeyCode::Joystick7Button13:
-  case KeyCode::Joystick7Button14:
-  case KeyCode::Joystick7Button15:
-  case KeyCode::Joystick7Button16:
-  case KeyCode::Joystick7Button17:
-  case KeyCode::Joystick7Button18:
-  case KeyCode::Joystick7Button19:
-  case KeyCode::Joystick8Button0:
-  case KeyCode::Joystick8Button1:
-  case KeyCode::Joystick8Button2:
-  case KeyCode::Joystick8Button3:
-  case KeyCode::Joystick8Button4:
-  case KeyCode::Joystick8Button5:
-  case KeyCode::Joystick8Button6:
-  case KeyCode::Joystick8Button7:
-  case KeyCode::Joystick8Button8:
-  case KeyCode::Joystick8Button9:
-  case KeyCode::Joystick8Button10:
-  case KeyCode::Joystick8Button11:
-  case KeyCode::Joystick8Button12:
-  case KeyCode::Joystick8Button13:
-  case KeyCode::Joystick8Button14:
-  case KeyCode::Joystick8Button15:
-  case KeyCode::Joystick8Button16:
-  case KeyCode::Joystick8Button17:
-  case KeyCode::Joystick8Button18:
-  case KeyCode::Joystick8Button19:
-    assert(0 && "Error: Unhandled keycode.");
-    return 0;
-  }
+} // namespace details
 
-  assert(0 && "Error: Unknown Key Code.");
-  return 0;
+/// @brief Converts Trundles key codes to GLFWs key codes.
+///
+/// @param[in] key The Trundle key code.
+/// @return The GLFW key code, or GLFW_KEY_UNKNOWN if GLFW has no such key.
+inline int TrundleToGL(KeyCode key) {
+  auto index = static_cast<size_t>(key);
+  return index < KeyCodeCount ? details::TrundleToGLTable[index]
+                              : GLFW_KEY_UNKNOWN;
 }
 
-/// @brief Converts Trundles key codes to GLFWs key codes.
+/// @brief Converts GLFWs key codes to Trundles key codes.
+///
+/// @param[in] keycode The GLFW key code.
+/// @return The Trundle key code, or KeyCode::None if the key is unknown.
 inline KeyCode GLToTrundle(int keycode) {
-  switch (keycode) {
-  case GLFW_KEY_SPACE:
-    return KeyCode::Space;
-  case GLFW_KEY_ESCAPE:
-    return KeyCode::Escape;
-  case GLFW_KEY_0:
-    return KeyCode::Alpha0;
-  case GLFW_KEY_1:
-    return KeyCode::Alpha1;
-  case GLFW_KEY_2:
-    return KeyCode::Alpha2;
-  case GLFW_KEY_3:
-    return KeyCode::Alpha3;
-  case GLFW_KEY_4:
-    return KeyCode::Alpha4;
-  case GLFW_KEY_5:
-    return KeyCode::Alpha5;
-  case GLFW_KEY_6:
-    return KeyCode::Alpha6;
-  case GLFW_KEY_7:
-    return KeyCode::Alpha7;
-  case GLFW_KEY_8:
-    return KeyCode::Alpha8;
-  case GLFW_KEY_9:
-    return KeyCode::Alpha9;
-  case GLFW_KEY_A:
-    return KeyCode::A;
-  case GLFW_KEY_B:
-    return KeyCode::B;
-  case GLFW_KEY_C:
-    return KeyCode::C;
-  case GLFW_KEY_D:
-    return KeyCode::D;
-  case GLFW_KEY_E:
-    return KeyCode::E;
-  case GLFW_KEY_F:
-    return KeyCode::F;
-  case GLFW_KEY_G:
-    return KeyCode::G;
-  case GLFW_KEY_H:
-    return KeyCode::H;
-  case GLFW_KEY_I:
-    return KeyCode::I;
-  case GLFW_KEY_J:
-    return KeyCode::J;
-  case GLFW_KEY_K:
-    return KeyCode::K;
-  case GLFW_KEY_L:
-    return KeyCode::L;
-  case GLFW_KEY_M:
-    return KeyCode::M;
-  case GLFW_KEY_N:
-    return KeyCode::N;
-  case GLFW_KEY_O:
-    return KeyCode::O;
-  case GLFW_KEY_P:
-    return KeyCode::P;
-  case GLFW_KEY_Q:
-    return KeyCode::Q;
-  case GLFW_KEY_R:
-    return KeyCode::R;
-  case GLFW_KEY_S:
-    return KeyCode::S;
-  case GLFW_KEY_T:
-    return KeyCode::T;
-  case GLFW_KEY_U:
-    return KeyCode::U;
-  case GLFW_KEY_V:
-    return KeyCode::V;
-  case GLFW_KEY_W:
-    return KeyCode::W;
-  case GLFW_KEY_X:
-    return KeyCode::X;
-  case GLFW_KEY_Y:
-    return KeyCode::Y;
-  case GLFW_KEY_Z:
-    return KeyCode::Z;
-  case GLFW_KEY_UP:
-    return KeyCode::Up;
-  case GLFW_KEY_DOWN:
-    return KeyCode::Down;
-  case GLFW_KEY_LEFT:
-    return KeyCode::Left;
-  case GLFW_KEY_RIGHT:
-    return KeyCode::Right;
-  default:
-    assert(0 && "Error: Unhandled GLFW case");
-  }
-
-  return KeyCode::None;
+  return keycode >= 0 && static_cast<size_t>(keycode) < details::GLKeyCount
+             ? details::GLToTrundleTable[static_cast<size_t>(keycode)]
+             : KeyCode::None;
 }
 
 } // namespace Trundle
\ No newline at end of file
@@ -20,32 +20,87 @@
 #include <Trundle/Events/windowEvent.h>
 #include <Trundle/Util/input.h>
 
+#include <atomic>
+
 namespace Trundle {
 
-Application* Application::instance = nullptr;
+namespace {
+
+// The application that is running on each thread.
+thread_local Application* currentApplication = nullptr;
+// The input of the application that is running on each thread, the
+// application is only current while its input is.
+thread_local InputContext* currentInput = nullptr;
+
+// The application used by threads that have none of their own, which is the
+// first application constructed in the process.
+std::atomic<Application*> primaryApplication{nullptr};
+
+// The most time that is simulated in one frame with a fixed timestep.
+constexpr Timestamp MaxFrameTime = 250000000;
+
+// The longest that an idle application waits for an event, in case a wake up
+// is missed.
+constexpr Timestamp MaxIdleWait = 1000000000;
+
+} // namespace
 
 Application::Application(bool runHeadless)
-  : headless(runHeadless) {
-  instance = this;
+  : headless(runHeadless), clock(std::make_shared<SystemClock>()),
+    timers(clock->now()), lastFrameTime(clock->now()) {
+  makeCurrent();
+
+  Application* expected = nullptr;
+  if (primaryApplication.compare_exchange_strong(expected, this)) {
+    Input::setPrimaryContext(&input);
+  }
 
   // Create a new window object.
   if (!headless) {
     window = Ref<Window>(Window::create());
-    window->setEventCallback([this](Event &e){ onEvent(e); });
+    input.getGamepads().setSource(
+        Ref<GamepadSource>(GamepadSource::create()));
   }
 }
 
-Application::~Application() {}
+Application::~Application() {
+  // Don't leave any thread pointing at a destroyed application, the other
+  // threads that ran it notice when their input is dropped.
+  Input::removeContext(&input);
+  if (currentApplication == this) {
+    currentApplication = nullptr;
+    currentInput = nullptr;
+  }
+  Application* expected = this;
+  primaryApplication.compare_exchange_strong(expected, nullptr);
+}
+
+Application* Application::get() {
+  if (currentApplication != nullptr &&
+      &Input::getContext() == currentInput) {
+    return currentApplication;
+  }
+  return primaryApplication.load(std::memory_order_acquire);
+}
+
+void Application::makeCurrent() {
+  currentApplication = this;
+  currentInput = &input;
+  Input::setContext(&input);
+}
 
 void Application::run() {
+  makeCurrent();
   while (running) {
-    for (auto layer : layerStack) {
-      layer->onUpdate();
-    }
-
     if (!headless) {
-      window->onUpdate();
+      pollWindow();
+      processEvents(window->getEventQueue());
     }
+    processPostedEvents();
+    processTimers();
+    updateFrame();
+    present();
+    waitForNextFrame();
   }
 }
 
@@ -54,84 +109,101 @@ void Application::run(Ref<Event> event) {
   if (!running) {
     return;
   }
-
-  onEvent(*event);
-  for (auto layer : layerStack) {
-    layer->onUpdate();
-  }
+  makeCurrent();
 
   if (!headless) {
-    window->onUpdate();
+    window->pollEvents();
+    processEvents(window->getEventQueue());
   }
+  processPostedEvents();
+  processTimers();
+
+  dispatchEvent(*event);
+  updateFrame();
+  present();
 }
 
-void Application::run(std::vector<Ref<Event>> events) {
-  for (auto event : events) {
+void Application::run(const std::vector<Ref<Event>>& events) {
+  for (const auto& event : events) {
     run(event);
   }
 }
 
 bool Application::onKeyPress(KeyPressEvent& event) {
   // Convert the OpenGL keycode to a Trundle keycode then register it as being
-  // pressed.
-  Input::setKeyDown(GLToTrundle(event.getKeyCode()));
+  // pressed. Keys without a Trundle keycode, such as media keys, are ignored.
+  KeyCode key = GLToTrundle(event.getKeyCode());
+  if (key == KeyCode::None) {
+    return false;
+  }
+  input.setKeyDown(key, event.isRepeatEvent());
   return true;
 }
 
 bool Application::onKeyRelease(KeyReleaseEvent& event) {
   // Convert the OpenGL keycode to a Trundle keycode then register it as being
   // released.
-  Input::setKeyUp(GLToTrundle(event.getKeyCode()));
+  KeyCode key = GLToTrundle(event.getKeyCode());
+  if (key == KeyCode::None) {
+    return false;
+  }
+  input.setKeyUp(key);
   return true;
 }
 
 bool Application::onMousePress(MousePressEvent& event) {
   // Register the mouse press.
-  Input::setMouseButtonDown(event.getMouseCode());
+  input.setMouseButtonDown(event.getMouseCode());
   return true;
 }
 
 bool Application::onMouseRelease(MouseReleaseEvent& event) {
   // Register the mouse release.
-  Input::setMouseButtonUp(event.getMouseCode());
+  input.setMouseButtonUp(event.getMouseCode());
   return true;
 }
 
 bool Application::onMouseMove(MouseMoveEvent& event) {
   // Register the mouse move.
   auto [x, y] = event.getPosition();
-  Input::setMousePosition(x, y);
+  input.setMousePosition(x, y);
+  auto [dx, dy] = event.getDelta();
+  input.addMouseDelta(dx, dy);
+  return true;
+}
+
+bool Application::onMouseScroll(MouseScrollEvent& event) {
+  // Register the scroll.
+  auto [x, y] = event.getOffset();
+  input.addScroll(x, y);
   return true;
 }
 
 void Application::onEvent(Event &event) {
-  EventDispatch dispatcher(event);
-  dispatcher.dispatch<WindowCloseEvent>(
-    [this](WindowCloseEvent &e)->bool { return onWindowClose(e); }
-  );
-  dispatcher.dispatch<KeyPressEvent>(
-    [this](KeyPressEvent &e)->bool { return onKeyPress(e); }
-  );
-  dispatcher.dispatch<KeyReleaseEvent>(
-    [this](KeyReleaseEvent &e)->bool { return onKeyRelease(e); }
-  );
-  dispatcher.dispatch<MousePressEvent>(
-    [this](MousePressEvent &e)->bool { return onMousePress(e); }
-  );
-  dispatcher.dispatch<MouseReleaseEvent>(
-    [this](MouseReleaseEvent &e)->bool { return onMouseRelease(e); }
-  );
-  dispatcher.dispatch<MouseMoveEvent>(
-    [this](MouseMoveEvent &e)->bool { return onMouseMove(e); }
-  );
+  // The engine's own handlers, built at compile time and indexed by the type
+  // of the event.
+  static constexpr auto dispatchTable =
+      EventDispatchTable<Application>()
+          .bind<WindowCloseEvent, &Application::onWindowClose>()
+          .bind<KeyPressEvent, &Application::onKeyPress>()
+          .bind<KeyReleaseEvent, &Application::onKeyRelease>()
+          .bind<MousePressEvent, &Application::onMousePress>()
+          .bind<MouseReleaseEvent, &Application::onMouseRelease>()
+          .bind<MouseMoveEvent, &Application::onMouseMove>()
+          .bind<MouseScrollEvent, &Application::onMouseScroll>();
+  dispatchTable.dispatch(*this, event);
 
   if (!event.handled) {
-    for (auto it = layerStack.begin(); it != layerStack.end(); ++it) {
-      (*it)->onEvent(event);
+    // Only offer the event to the layers that asked for its type. Layers
+    // pushed or popped by a handler take effect at the end of the frame.
+    layerStack.beginTraversal();
+    for (Layer* layer : layerStack.getSubscribers(event.getEventType())) {
+      layer->onEvent(event);
       if (event.handled) {
         break;
       }
     }
+    layerStack.endTraversal();
 
     if(!event.handled) {
       Log::Info(event.toString());
@@ -139,18 +211,300 @@ void Application::onEvent(Event &event) {
   }
 }
 
+void Application::dispatchEvent(Event& event) {
+  if (recorder.isOpen()) {
+    recorder.record(toEventData(event), event.timestamp, frame);
+  }
+  onEvent(event);
+}
+
+void Application::processEvents(EventQueue& queue) {
+  eventQueueDepth = queue.size();
+  for (Event* event : queue) {
+    dispatchEvent(*event);
+    if (event->timestamp != 0) {
+      frameLatencies.emplace_back(event->timestamp, getTimestamp());
+    }
+  }
+  queue.clear();
+}
+
+bool Application::startRecording(const std::string& path) {
+  return recorder.open(path);
+}
+
+void Application::stopRecording() {
+  recorder.close();
+}
+
+size_t Application::replay(const std::string& path) {
+  makeCurrent();
+  EventLog log(path);
+  if (!log.isValid()) {
+    Log::Error("Unable to read the event log " + path);
+    return 0;
+  }
+
+  // Gamepads are not recorded, so hide the live ones until the replay ends.
+  GamepadContext& gamepads = input.getGamepads();
+  Ref<GamepadSource> liveGamepads = gamepads.getSource();
+  gamepads.setSource(std::make_shared<ManualGamepadSource>());
+
+  size_t replayed = 0;
+  // Set while there are events that have not been followed by an update.
+  bool pending = false;
+  Timestep step = fixedStep;
+  for (size_t i = 0; i < log.size() && running; ++i) {
+    EventRecord record = log[i];
+    if (record.type == UpdateRecordType) {
+      step = Timestep(getUpdateStep(record));
+      updateLayers(step);
+      pending = false;
+      continue;
+    }
+    withEvent(toEventData(record), [this](Event& e) { onEvent(e); });
+    ++replayed;
+    pending = true;
+  }
+
+  // The recording may have stopped before the frame of its last events was
+  // updated.
+  if (pending) {
+    updateLayers(step);
+  }
+  gamepads.setSource(std::move(liveGamepads));
+  return replayed;
+}
+
+void Application::updateFrame() {
+  Timestamp now = clock->now();
+  Timestamp elapsed = std::min(now - lastFrameTime, MaxFrameTime);
+  lastFrameTime = now;
+
+  if (fixedStep.getNanoseconds() == 0) {
+    updateLayers(Timestep(elapsed));
+    alpha = 1.0f;
+  } else {
+    accumulator += elapsed;
+    while (accumulator >= fixedStep.getNanoseconds()) {
+      updateLayers(fixedStep);
+      accumulator -= fixedStep.getNanoseconds();
+    }
+    alpha = static_cast<float>(accumulator) /
+            static_cast<float>(fixedStep.getNanoseconds());
+  }
+  renderLayers();
+}
+
+void Application::updateLayers(Timestep step) {
+  if (recorder.isOpen()) {
+    recorder.recordUpdate(step.getNanoseconds(), frame);
+  }
+  input.beginFrame();
+  input.getGamepads().poll();
+  InputSnapshot snapshot = input.getSnapshot();
+  inputHistory.push(InputRecord::fromSnapshot(snapshot));
+  inputActions.update(snapshot);
+  layerStack.beginTraversal();
+  for (const std::vector<Layer*>& level : layerStack.getUpdateLevels()) {
+    if (updatePool) {
+      updatePool->run(level.size(), [this, &level, step](size_t i) {
+        // Layers read the input and the application through the thread's
+        // current application.
+        makeCurrent();
+        level[i]->onUpdate(step);
+      });
+    } else {
+      for (Layer* layer : level) {
+        layer->onUpdate(step);
+      }
+    }
+  }
+  layerStack.endTraversal();
+  layerStack.applyPending();
+  ++frame;
+}
+
+void Application::renderLayers() {
+  layerStack.beginTraversal();
+  for (Layer* layer : layerStack.getLayers()) {
+    layer->onRender(alpha);
+  }
+  layerStack.endTraversal();
+  layerStack.applyPending();
+}
+
+void Application::present() {
+  if (!headless) {
+    window->onUpdate();
+    if (reconcileKeys) {
+      reconcileKeyState();
+    }
+  }
+
+  Timestamp presented = getTimestamp();
+  handlingLatency.clear();
+  presentLatency.clear();
+  for (auto [arrived, handled] : frameLatencies) {
+    handlingLatency.record(handled - arrived);
+    presentLatency.record(presented - arrived);
+  }
+  frameLatencies.clear();
+}
+
+void Application::reconcileKeyState() {
+  // Only the held keys are checked, a missed press is corrected by the next
+  // event for that key while a missed release would leave it stuck.
+  EventQueue& queue = window->getEventQueue();
+  input.handleKeysDown([this, &queue](KeyCode key) {
+    int glfwKey = TrundleToGL(key);
+    if (glfwKey != GLFW_KEY_UNKNOWN && !window->isKeyPressed(key)) {
+      queue.push<KeyReleaseEvent>(glfwKey);
+    }
+  });
+}
+
+void Application::setEventCoalescing(bool enable) {
+  if (!headless) {
+    window->getEventQueue().setCoalescing(enable);
+  }
+}
+
+void Application::setFrameRateLimit(uint32_t hertz) {
+  frameLimiter.setRate(hertz);
+}
+
+void Application::requestFrame() {
+  frameRequested.store(true);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting.load(std::memory_order_relaxed)) {
+    window->wake();
+  }
+}
+
+void Application::pollWindow() {
+  // A frame requested before this point is the one about to run.
+  if (!idle || frameRequested.exchange(false)) {
+    window->pollEvents();
+    return;
+  }
+
+  // Sleep until an event arrives or the next timer is due.
+  Timestamp now = clock->now();
+  Timestamp wake = timers.getNextWake();
+  Timestamp timeout = std::min(wake > now ? wake - now : 0, MaxIdleWait);
+
+  waiting.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (timeout != 0 && postedEvents.empty() && !frameRequested.load()) {
+    window->waitEvents(timeout);
+  } else {
+    window->pollEvents();
+  }
+  waiting.store(false, std::memory_order_relaxed);
+}
+
+void Application::waitForNextFrame() {
+  if (frameLimiter.getRate() != 0) {
+    frameLimiter.wait();
+  } else if (headless && fixedStep.getNanoseconds() != 0) {
+    // A headless server has nothing to present, so rather than spinning it
+    // waits for the next fixed update.
+    std::this_thread::sleep_for(std::chrono::nanoseconds(
+        fixedStep.getNanoseconds() - accumulator));
+  }
+}
+
+void Application::setUpdateThreads(size_t threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // The main thread always takes part, so only the rest need workers.
+  if (threads == 1) {
+    updatePool.reset();
+  } else if (getUpdateThreads() != threads) {
+    updatePool = std::make_unique<WorkerPool>(threads - 1);
+  }
+}
+
+size_t Application::getUpdateThreads() const {
+  return updatePool ? updatePool->size() : 1;
+}
+
+bool Application::setRawMouseMotion(bool enable) {
+  if (headless) {
+    return false;
+  }
+  return window->setRawMouseMotion(enable);
+}
+
+bool Application::postEvent(const EventData& event) {
+  if (!postedEvents.push(event)) {
+    return false;
+  }
+  // Pairs with the fence in pollWindow, so either the main loop sees the
+  // event before it waits or we see that it is waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting.load(std::memory_order_relaxed)) {
+    window->wake();
+  }
+  return true;
+}
+
+void Application::processPostedEvents() {
+  EventData event;
+  while (postedEvents.pop(event)) {
+    withEvent(event, [this](Event& e) { dispatchEvent(e); });
+  }
+}
+
 bool Application::onWindowClose(WindowCloseEvent &event) {
   running = false;
   event.handled = true;
   return true;
 }
 
-void Application::pushLayer(Ref<Layer> layer) {
-  layerStack.pushLayer(layer);
+TimerHandle Application::scheduleTimer(Timestamp delay, uint32_t code,
+                                       Timestamp period) {
+  return timers.schedule(clock->now() + delay, code, period);
+}
+
+bool Application::cancelTimer(TimerHandle handle) {
+  return timers.cancel(handle);
 }
 
-void Application::pushOverlay(Ref<Layer> overlay) {
-  layerStack.pushOverlay(overlay);
+void Application::processTimers() {
+  timers.advance(clock->now(), expiredTimers);
+  for (const auto& timer : expiredTimers) {
+    TimerEvent event(timer.handle, timer.code);
+    dispatchEvent(event);
+  }
+  expiredTimers.clear();
+}
+
+void Application::setClock(Ref<Clock> newClock) {
+  clock = std::move(newClock);
+  timers = TimerWheel(clock->now());
+  lastFrameTime = clock->now();
+  accumulator = 0;
+}
+
+void Application::setFixedTimestep(uint32_t hertz) {
+  fixedStep = hertz == 0 ? Timestep() : Timestep::fromRate(hertz);
+  // Start measuring from now, so time spent without a fixed step is not
+  // simulated all at once.
+  lastFrameTime = clock->now();
+  accumulator = 0;
+  alpha = 1.0f;
+}
+
+LayerHandle Application::pushLayer(Ref<Layer> layer) {
+  return layerStack.pushLayer(layer);
+}
+
+LayerHandle Application::pushOverlay(Ref<Layer> overlay) {
+  return layerStack.pushOverlay(overlay);
 }
 
 void Application::popLayer(Ref<Layer> layer) {
@@ -161,4 +515,8 @@ void Application::popOverlay(Ref<Layer> overlay) {
   layerStack.popOverlay(overlay);
 }
 
+void Application::popLayer(LayerHandle layer) {
+  layerStack.pop(layer);
+}
+
 } // namespace Trundle
\ No newline at end of file
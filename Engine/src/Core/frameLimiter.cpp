@@ -0,0 +1,63 @@
+//===-- frameLimiter.cpp --------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Core/frameLimiter.h>
+
+namespace Trundle {
+
+FrameLimiter::FrameLimiter(uint32_t hertz) {
+  setRate(hertz);
+}
+
+void FrameLimiter::setRate(uint32_t hertz) {
+  rate = hertz;
+  period = hertz == 0 ? 0 : 1000000000ull / hertz;
+  reset();
+}
+
+void FrameLimiter::setSpinThreshold(Timestamp threshold) {
+  spinThreshold = threshold;
+}
+
+void FrameLimiter::wait() {
+  if (period == 0) {
+    return;
+  }
+
+  Timestamp now = getTimestamp();
+  if (deadline == 0 || now >= deadline + period) {
+    deadline = now + period;
+    return;
+  }
+
+  if (now < deadline) {
+    if (deadline - now > spinThreshold) {
+      std::this_thread::sleep_for(
+          std::chrono::nanoseconds(deadline - now - spinThreshold));
+    }
+    while (getTimestamp() < deadline) {
+      std::this_thread::yield();
+    }
+  }
+  deadline += period;
+}
+
+void FrameLimiter::reset() {
+  deadline = 0;
+}
+
+} // namespace Trundle
@@ -0,0 +1,154 @@
+//===-- gamepad.cpp -------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Core/gamepad.h>
+#include <Trundle/Core/input.h>
+
+namespace Trundle {
+
+//===-- GamepadContext ----------------------------------------------------===//
+void GamepadContext::setSource(Ref<GamepadSource> newSource) {
+  source = std::move(newSource);
+}
+
+void GamepadContext::poll() {
+  previousButtonsDown = buttonsDown;
+  connected = 0;
+
+  for (size_t id = 0; id < GamepadCount; ++id) {
+    // A gamepad that is not connected reads as being at rest.
+    GamepadState state;
+    if (source && source->read(id, state)) {
+      connected |= uint32_t(1) << id;
+    } else {
+      state = GamepadState();
+    }
+
+    buttonsDown[id] = state.buttons;
+    for (size_t axis = 0; axis < GamepadAxisCount; ++axis) {
+      rawAxes[axis][id] = state.axes[axis];
+    }
+  }
+
+  for (size_t id = 0; id < GamepadCount; ++id) {
+    uint32_t changed = buttonsDown[id] ^ previousButtonsDown[id];
+    buttonsPressed[id] = changed & buttonsDown[id];
+    buttonsReleased[id] = changed & previousButtonsDown[id];
+  }
+
+  applyDeadZone();
+}
+
+void GamepadContext::applyDeadZone() {
+  // Only the sticks have a dead zone, they are the first four axes.
+  constexpr size_t StickAxisCount =
+      static_cast<size_t>(GamepadAxis::RightY) + 1;
+  const float scale = 1.0f / (1.0f - deadZone);
+  for (size_t axis = 0; axis < StickAxisCount; ++axis) {
+    const std::array<float, GamepadCount>& in = rawAxes[axis];
+    std::array<float, GamepadCount>& out = axes[axis];
+    // Branch free so that every gamepad is handled in a few vector
+    // instructions.
+    for (size_t id = 0; id < GamepadCount; ++id) {
+      float magnitude = std::max(std::fabs(in[id]) - deadZone, 0.0f) * scale;
+      out[id] = std::copysign(std::min(magnitude, 1.0f), in[id]);
+    }
+  }
+
+  for (size_t axis = StickAxisCount; axis < GamepadAxisCount; ++axis) {
+    axes[axis] = rawAxes[axis];
+  }
+}
+
+void GamepadContext::setDeadZone(float newDeadZone) {
+  assert(newDeadZone >= 0 && newDeadZone < 1 && "Error: Invalid dead zone.");
+  deadZone = newDeadZone;
+  applyDeadZone();
+}
+
+float GamepadContext::getDeadZone() const {
+  return deadZone;
+}
+
+bool GamepadContext::isConnected(size_t id) const {
+  assert(id < GamepadCount && "Error: Not a gamepad.");
+  return (connected >> id) & 1;
+}
+
+bool GamepadContext::isButtonDown(size_t id, GamepadButton button) const {
+  assert(id < GamepadCount && "Error: Not a gamepad.");
+  return (buttonsDown[id] >> static_cast<uint32_t>(button)) & 1;
+}
+
+bool GamepadContext::wasPressedThisFrame(size_t id,
+                                         GamepadButton button) const {
+  assert(id < GamepadCount && "Error: Not a gamepad.");
+  return (buttonsPressed[id] >> static_cast<uint32_t>(button)) & 1;
+}
+
+bool GamepadContext::wasReleasedThisFrame(size_t id,
+                                          GamepadButton button) const {
+  assert(id < GamepadCount && "Error: Not a gamepad.");
+  return (buttonsReleased[id] >> static_cast<uint32_t>(button)) & 1;
+}
+
+float GamepadContext::getAxis(size_t id, GamepadAxis axis) const {
+  assert(id < GamepadCount && "Error: Not a gamepad.");
+  return axes[static_cast<size_t>(axis)][id];
+}
+//===----------------------------------------------------------------------===//
+
+
+//===-- Gamepads ----------------------------------------------------------===//
+void Gamepads::setSource(Ref<GamepadSource> source) {
+  Input::getContext().getGamepads().setSource(std::move(source));
+}
+
+void Gamepads::poll() {
+  Input::getContext().getGamepads().poll();
+}
+
+void Gamepads::setDeadZone(float deadZone) {
+  Input::getContext().getGamepads().setDeadZone(deadZone);
+}
+
+float Gamepads::getDeadZone() {
+  return Input::getContext().getGamepads().getDeadZone();
+}
+
+bool Gamepads::isConnected(size_t id) {
+  return Input::getContext().getGamepads().isConnected(id);
+}
+
+bool Gamepads::isButtonDown(size_t id, GamepadButton button) {
+  return Input::getContext().getGamepads().isButtonDown(id, button);
+}
+
+bool Gamepads::wasPressedThisFrame(size_t id, GamepadButton button) {
+  return Input::getContext().getGamepads().wasPressedThisFrame(id, button);
+}
+
+bool Gamepads::wasReleasedThisFrame(size_t id, GamepadButton button) {
+  return Input::getContext().getGamepads().wasReleasedThisFrame(id, button);
+}
+
+float Gamepads::getAxis(size_t id, GamepadAxis axis) {
+  return Input::getContext().getGamepads().getAxis(id, axis);
+}
+//===----------------------------------------------------------------------===//
+
+} // namespace Trundle
@@ -16,107 +16,238 @@
 //
 //===----------------------------------------------------------------------===//
 #include <Trundle/Core/input.h>
-#include <Trundle/Util/input.h>
 
-// Temp
-#include <GL/gl3w.h>
-#include <GLFW/glfw3.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 namespace Trundle {
 
-std::array<bool, 325> Input::keysDown{};
-std::array<bool, 3> Input::mouseButtonsDown{};
-double Input::mouseX = 0;
-double Input::mouseY = 0;
+namespace {
+
+// The context that the static Input functions forward to on each thread, and
+// the id it had when it was made current.
+thread_local InputContext* currentContext = nullptr;
+thread_local uint64_t currentContextId = 0;
+
+// The contexts that have been made current and not removed since, each with
+// an id so that a new context at the address of a removed one is not
+// mistaken for it.
+std::mutex contextsMutex;
+std::unordered_map<const InputContext*, uint64_t> liveContexts;
+uint64_t nextContextId = 1;
+// Bumped whenever a context is removed, so each thread only checks its
+// context again after a removal.
+std::atomic<uint64_t> contextRemovals{0};
+thread_local uint64_t seenContextRemovals = 0;
+
+// The context used by threads that have not set their own.
+std::atomic<InputContext*> primaryContext{nullptr};
+
+// Drops the context of the calling thread if it was removed on another
+// thread.
+void dropRemovedContext() {
+  std::lock_guard<std::mutex> lock(contextsMutex);
+  seenContextRemovals = contextRemovals.load(std::memory_order_relaxed);
+  auto live = liveContexts.find(currentContext);
+  if (live == liveContexts.end() || live->second != currentContextId) {
+    currentContext = nullptr;
+  }
+}
+
+} // namespace
+
+InputContext& Input::getContext() {
+  if (currentContext != nullptr &&
+      seenContextRemovals !=
+          contextRemovals.load(std::memory_order_acquire)) {
+    dropRemovedContext();
+  }
+  if (currentContext != nullptr) {
+    return *currentContext;
+  }
+  if (InputContext* primary = primaryContext.load(std::memory_order_acquire)) {
+    return *primary;
+  }
+  // Shared by every thread while there is no primary context.
+  static InputContext defaultContext;
+  return defaultContext;
+}
+
+void Input::setContext(InputContext* context) {
+  if (context == nullptr) {
+    currentContext = nullptr;
+    return;
+  }
+  if (context == currentContext &&
+      seenContextRemovals ==
+          contextRemovals.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(contextsMutex);
+  auto [live, added] = liveContexts.try_emplace(context, nextContextId);
+  if (added) {
+    ++nextContextId;
+  }
+  currentContext = context;
+  currentContextId = live->second;
+  seenContextRemovals = contextRemovals.load(std::memory_order_relaxed);
+}
+
+void Input::removeContext(InputContext* context) {
+  {
+    std::lock_guard<std::mutex> lock(contextsMutex);
+    liveContexts.erase(context);
+    contextRemovals.fetch_add(1, std::memory_order_release);
+  }
+  if (currentContext == context) {
+    currentContext = nullptr;
+  }
+  primaryContext.compare_exchange_strong(context, nullptr);
+}
 
-bool Input::isKeyPressed(KeyCode keycode) {
-  Application* app = Application::get();
-  GLFWwindow* window =
-      static_cast<GLFWwindow*>(app->getWindow()->getNativeWindow());
-  int status = glfwGetKey(window, TrundleToGL(keycode));
+void Input::setPrimaryContext(InputContext* context) {
+  primaryContext.store(context, std::memory_order_release);
+}
 
-  return status == GLFW_PRESS;
+bool InputContext::isKeyPressed(KeyCode keycode) const {
+  return keysDown.test(static_cast<size_t>(keycode));
 }
 
-void Input::setKeyDown(KeyCode keycode) {
-  keysDown[static_cast<int>(keycode)] = true;
+void InputContext::setKeyDown(KeyCode keycode, bool repeat) {
+  keysDown.set(static_cast<size_t>(keycode));
+  if (!repeat) {
+    keysPressedLatch.set(static_cast<size_t>(keycode));
+  }
 }
-void Input::setKeyUp(KeyCode keycode) {
-  keysDown[static_cast<int>(keycode)] = false;
+void InputContext::setKeyUp(KeyCode keycode) {
+  keysDown.reset(static_cast<size_t>(keycode));
+  keysReleasedLatch.set(static_cast<size_t>(keycode));
 }
 
-void Input::setMouseButtonDown(int buttonNum) {
+bool InputContext::wasPressedThisFrame(KeyCode keycode) const {
+  return keysPressed.test(static_cast<size_t>(keycode));
+}
+
+bool InputContext::wasReleasedThisFrame(KeyCode keycode) const {
+  return keysReleased.test(static_cast<size_t>(keycode));
+}
+
+void InputContext::beginFrame() {
+  // Keys that changed state since the last frame, plus keys that went both
+  // down and up within it. Repeats do not set the pressed latch, so a held
+  // key that repeats and is then released is not reported as pressed.
+  KeySet changed = keysDown ^ previousKeysDown;
+  KeySet tapped = keysPressedLatch & keysReleasedLatch;
+  keysPressed = (changed & keysDown) | tapped;
+  keysReleased = (changed & previousKeysDown) | tapped;
+
+  previousKeysDown = keysDown;
+  keysPressedLatch.reset();
+  keysReleasedLatch.reset();
+
+  mouseDeltaX = pendingDeltaX;
+  mouseDeltaY = pendingDeltaY;
+  scrollX = pendingScrollX;
+  scrollY = pendingScrollY;
+  pendingDeltaX = pendingDeltaY = 0;
+  pendingScrollX = pendingScrollY = 0;
+
+  InputSnapshot state;
+  state.frame = ++frame;
+  state.keysDown = keysDown;
+  state.keysPressed = keysPressed;
+  state.keysReleased = keysReleased;
+  for (size_t i = 0; i < mouseButtonsDown.size(); ++i) {
+    state.mouseButtonsDown |= uint32_t(mouseButtonsDown[i]) << i;
+  }
+  state.mouseX = mouseX;
+  state.mouseY = mouseY;
+  state.mouseDeltaX = mouseDeltaX;
+  state.mouseDeltaY = mouseDeltaY;
+  state.scrollX = scrollX;
+  state.scrollY = scrollY;
+  snapshot.store(state);
+}
+
+InputSnapshot InputContext::getSnapshot() const {
+  return snapshot.load();
+}
+
+void InputContext::setMouseButtonDown(int buttonNum) {
   assert(buttonNum == 0 || buttonNum == 1 || buttonNum == 2 
          && "Not a mouse button");
   mouseButtonsDown[buttonNum] = true;
 }
 
-void Input::setMouseButtonUp(int buttonNum) {
+void InputContext::setMouseButtonUp(int buttonNum) {
   assert(buttonNum == 0 || buttonNum == 1 || buttonNum == 2 
          && "Not a mouse button");
   mouseButtonsDown[buttonNum] = false;
 }
 
-void Input::setMousePosition(double x, double y) {
-  assert(x >= 0 && y >= 0 && "Invalid mouse position");
+void InputContext::setMousePosition(double x, double y) {
   mouseX = x;
   mouseY = y;
 }
 
-void Input::setMousePositionX(double x) {
-  assert(x >= 0 && "Invalid mouse position");
+void InputContext::setMousePositionX(double x) {
   mouseX = x;
 }
 
-void Input::setMousePositionY(double y) {
-  assert(y >= 0 && "Invalid mouse position");
+void InputContext::setMousePositionY(double y) {
   mouseY = y;
 }
 
-// TODO: Add some sort of keyup handling
-void Input::handleKeysDown(std::function<void(KeyCode)> func) {
-  for (size_t i = 0; i < keysDown.size(); ++i) {
-    if (keysDown[i]) {
-      if (!isKeyDown(static_cast<KeyCode>(i))) {
-        keysDown[i] = false;
-        continue;
-      } else {
-        func(static_cast<KeyCode>(i));
-      }
-    }
-  }
+void InputContext::addMouseDelta(double dx, double dy) {
+  pendingDeltaX += dx;
+  pendingDeltaY += dy;
+}
+
+void InputContext::addScroll(double x, double y) {
+  pendingScrollX += x;
+  pendingScrollY += y;
 }
 
-bool Input::isKeyDown(KeyCode keycode) {
-  return keysDown[static_cast<int>(keycode)];
+bool InputContext::isKeyDown(KeyCode keycode) const {
+  return keysDown.test(static_cast<size_t>(keycode));
 }
 
-bool Input::isKeyUp(KeyCode keycode) {
-  return !keysDown[static_cast<int>(keycode)];
+bool InputContext::isKeyUp(KeyCode keycode) const {
+  return !keysDown.test(static_cast<size_t>(keycode));
 }
 
-bool Input::isMouseButtonDown(int buttonNum) {
+bool InputContext::isMouseButtonDown(int buttonNum) const {
   assert(buttonNum == 0 || buttonNum == 1 || buttonNum == 2 
          && "Not a mouse button");
   return mouseButtonsDown[buttonNum];
 }
 
-bool Input::isMouseButtonUp(int buttonNum) {
+bool InputContext::isMouseButtonUp(int buttonNum) const {
   assert(buttonNum == 0 || buttonNum == 1 || buttonNum == 2 
          && "Not a mouse button");
   return !mouseButtonsDown[buttonNum];
 }
 
-std::tuple<double, double> Input::getMousePosition() {
+std::tuple<double, double> InputContext::getMousePosition() const {
   return {mouseX, mouseY};
 }
 
-double Input::getMousePositionX() {
+double InputContext::getMousePositionX() const {
   return mouseX;
 }
 
-double Input::getMousePositionY() {
+double InputContext::getMousePositionY() const {
   return mouseY;
 }
 
+std::tuple<double, double> InputContext::getMouseDelta() const {
+  return {mouseDeltaX, mouseDeltaY};
+}
+
+std::tuple<double, double> InputContext::getScrollDelta() const {
+  return {scrollX, scrollY};
+}
+
 } // namespace Trundle
\ No newline at end of file
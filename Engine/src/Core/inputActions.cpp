@@ -0,0 +1,121 @@
+//===-- inputActions.cpp --------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Core/inputActions.h>
+
+namespace Trundle {
+
+namespace {
+
+// Checks if exactly one bit of a set of keys is set.
+bool isSingleKey(const BitSet<384>& keys) {
+  size_t count = 0;
+  for (uint64_t word : keys.getWords()) {
+    if (word != 0) {
+      // More than one bit in a word, or bits in more than one word.
+      if ((word & (word - 1)) != 0 || ++count > 1) {
+        return false;
+      }
+    }
+  }
+  return count == 1;
+}
+
+} // namespace
+
+ActionId InputActions::addAction(const std::string& name) {
+  assert(findAction(name) == InvalidAction &&
+         "Error: An action with this name already exists.");
+  names.push_back(name);
+  states.emplace_back();
+  return static_cast<ActionId>(states.size() - 1);
+}
+
+void InputActions::bind(ActionId action, std::initializer_list<KeyCode> keys,
+                        std::initializer_list<int> mouseButtons) {
+  assert(action < states.size() && "Error: Unknown action.");
+  assert(keys.size() + mouseButtons.size() > 0 &&
+         "Error: A binding needs at least one key or mouse button.");
+
+  Binding binding;
+  binding.action = action;
+  for (KeyCode key : keys) {
+    binding.keys.set(static_cast<size_t>(key));
+  }
+  for (int button : mouseButtons) {
+    assert((button == 0 || button == 1 || button == 2) &&
+           "Error: Not a mouse button.");
+    binding.mouseButtons |= uint32_t(1) << button;
+  }
+  bindings.push_back(binding);
+}
+
+void InputActions::unbind(ActionId action) {
+  assert(action < states.size() && "Error: Unknown action.");
+  bindings.erase(std::remove_if(bindings.begin(), bindings.end(),
+                                [action](const Binding& binding) {
+                                  return binding.action == action;
+                                }),
+                 bindings.end());
+}
+
+ActionId InputActions::findAction(const std::string& name) const {
+  auto it = std::find(names.begin(), names.end(), name);
+  if (it == names.end()) {
+    return InvalidAction;
+  }
+  return static_cast<ActionId>(it - names.begin());
+}
+
+void InputActions::update(const InputSnapshot& input) {
+  // Keep whether each action was held last frame in released and whether a
+  // binding was tapped this frame in pressed until the edges are found.
+  for (ActionState& state : states) {
+    state.released = state.down;
+    state.down = false;
+    state.pressed = false;
+  }
+
+  BitSet<384> keysTapped = input.keysPressed & input.keysReleased;
+  for (const Binding& binding : bindings) {
+    bool buttonsHeld = (input.mouseButtonsDown & binding.mouseButtons) ==
+                       binding.mouseButtons;
+    BitSet<384> keysMissing = binding.keys & ~input.keysDown;
+    bool held = buttonsHeld && keysMissing.none();
+    // The snapshot does not say when each key went down, so a chord is only
+    // known to have been held if every key but one is still held and that
+    // one was pressed and released during the frame.
+    bool tapped = buttonsHeld && isSingleKey(keysMissing) &&
+                  (keysTapped & keysMissing) == keysMissing;
+    states[binding.action].down |= held;
+    states[binding.action].pressed |= tapped;
+  }
+
+  for (ActionState& state : states) {
+    bool wasDown = state.released;
+    bool tapped = state.pressed;
+    state.pressed = (state.down || tapped) && !wasDown;
+    state.released = !state.down && (wasDown || tapped);
+  }
+}
+
+const std::string& InputActions::getName(ActionId action) const {
+  assert(action < names.size() && "Error: Unknown action.");
+  return names[action];
+}
+
+} // namespace Trundle
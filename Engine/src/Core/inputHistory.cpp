@@ -0,0 +1,195 @@
+//===-- inputHistory.cpp --------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Core/inputHistory.h>
+
+#include <cstring>
+
+namespace Trundle {
+
+namespace {
+
+// The frame of a slot that holds no record.
+constexpr uint64_t NoFrame = ~uint64_t(0);
+
+void writeU64(std::vector<uint8_t>& out, uint64_t value) {
+  for (int i = 0; i < 8; ++i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void writeU32(std::vector<uint8_t>& out, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void writeDouble(std::vector<uint8_t>& out, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  writeU64(out, bits);
+}
+
+uint64_t readU64(const uint8_t*& data) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) {
+    value |= uint64_t(data[i]) << (8 * i);
+  }
+  data += 8;
+  return value;
+}
+
+uint32_t readU32(const uint8_t*& data) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value |= uint32_t(data[i]) << (8 * i);
+  }
+  data += 4;
+  return value;
+}
+
+double readDouble(const uint8_t*& data) {
+  uint64_t bits = readU64(data);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+} // namespace
+
+InputRecord InputRecord::fromSnapshot(const InputSnapshot& snapshot) {
+  InputRecord record;
+  record.frame = snapshot.frame;
+  record.keysDown = snapshot.keysDown;
+  record.mouseButtonsDown = snapshot.mouseButtonsDown;
+  record.mouseX = snapshot.mouseX;
+  record.mouseY = snapshot.mouseY;
+  return record;
+}
+
+InputHistory::InputHistory(size_t capacity)
+  : records(capacity), mask(capacity - 1) {
+  assert(capacity >= 1 && (capacity & (capacity - 1)) == 0 &&
+         "Error: Input history capacity must be a power of two.");
+  clear();
+}
+
+void InputHistory::push(const InputRecord& record) {
+  assert((count == 0 || record.frame > newest) &&
+         "Error: Input records must be pushed in frame order.");
+  // The history covers a window of frames ending at the newest, frames that
+  // were skipped are in the window but their slots hold older records.
+  if (count == 0) {
+    count = 1;
+  } else {
+    uint64_t skipped = record.frame - newest;
+    count = static_cast<size_t>(std::min<uint64_t>(count + skipped,
+                                                   capacity()));
+  }
+  newest = record.frame;
+  records[record.frame & mask] = record;
+}
+
+const InputRecord* InputHistory::get(uint64_t frame) const {
+  if (count == 0 || frame > newest || newest - frame >= count) {
+    return nullptr;
+  }
+  const InputRecord& record = records[frame & mask];
+  return record.frame == frame ? &record : nullptr;
+}
+
+bool InputHistory::wasPressed(uint64_t frame, KeyCode keycode) const {
+  const InputRecord* current = get(frame);
+  const InputRecord* previous = frame > 0 ? get(frame - 1) : nullptr;
+  auto key = static_cast<size_t>(keycode);
+  return current && previous && current->keysDown.test(key) &&
+         !previous->keysDown.test(key);
+}
+
+bool InputHistory::wasReleased(uint64_t frame, KeyCode keycode) const {
+  const InputRecord* current = get(frame);
+  const InputRecord* previous = frame > 0 ? get(frame - 1) : nullptr;
+  auto key = static_cast<size_t>(keycode);
+  return current && previous && !current->keysDown.test(key) &&
+         previous->keysDown.test(key);
+}
+
+void InputHistory::clear() {
+  // Frames that are skipped after clearing must not find the old records.
+  for (InputRecord& record : records) {
+    record.frame = NoFrame;
+  }
+  count = 0;
+  newest = 0;
+}
+
+void InputHistory::serialize(std::vector<uint8_t>& out) const {
+  // Frames that were skipped have no record and are not written.
+  uint64_t recordCount = 0;
+  for (size_t i = 0; i < count; ++i) {
+    recordCount += get(getOldestFrame() + i) != nullptr;
+  }
+
+  out.reserve(out.size() + 8 + recordCount * InputRecord::SerializedSize);
+  writeU64(out, recordCount);
+  for (size_t i = 0; i < count; ++i) {
+    const InputRecord* record = get(getOldestFrame() + i);
+    if (!record) {
+      continue;
+    }
+    writeU64(out, record->frame);
+    for (uint64_t word : record->keysDown.getWords()) {
+      writeU64(out, word);
+    }
+    writeU32(out, record->mouseButtonsDown);
+    writeDouble(out, record->mouseX);
+    writeDouble(out, record->mouseY);
+  }
+}
+
+bool InputHistory::deserialize(const uint8_t* data, size_t size) {
+  clear();
+  if (size < 8) {
+    return false;
+  }
+  const uint8_t* end = data + size;
+  uint64_t recordCount = readU64(data);
+  if (recordCount > capacity() ||
+      static_cast<size_t>(end - data) !=
+          recordCount * InputRecord::SerializedSize) {
+    return false;
+  }
+
+  for (uint64_t i = 0; i < recordCount; ++i) {
+    InputRecord record;
+    record.frame = readU64(data);
+    for (uint64_t& word : record.keysDown.getWords()) {
+      word = readU64(data);
+    }
+    record.mouseButtonsDown = readU32(data);
+    record.mouseX = readDouble(data);
+    record.mouseY = readDouble(data);
+    if (count != 0 && record.frame <= newest) {
+      clear();
+      return false;
+    }
+    push(record);
+  }
+  return true;
+}
+
+} // namespace Trundle
@@ -0,0 +1,80 @@
+//===-- latencyHistogram.cpp ----------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Core/latencyHistogram.h>
+
+#include <Trundle/Core/bits.h>
+
+namespace Trundle {
+
+size_t LatencyHistogram::getBucket(Timestamp latency) {
+  if (latency == 0) {
+    return 0;
+  }
+  // The bucket is the number of significant bits in the latency.
+  return 64 - countLeadingZeros(latency);
+}
+
+void LatencyHistogram::record(Timestamp latency) {
+  ++buckets[getBucket(latency)];
+  ++count;
+  total += latency;
+  min = std::min(min, latency);
+  max = std::max(max, latency);
+}
+
+void LatencyHistogram::clear() {
+  buckets.fill(0);
+  count = 0;
+  total = 0;
+  min = ~Timestamp(0);
+  max = 0;
+}
+
+Timestamp LatencyHistogram::getMean() const {
+  return count ? total / count : 0;
+}
+
+Timestamp LatencyHistogram::getPercentile(double percentile) const {
+  if (count == 0) {
+    return 0;
+  }
+
+  // The number of samples at or below the percentile, rounded up.
+  auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * count));
+  rank = std::max<size_t>(rank, 1);
+
+  size_t seen = 0;
+  for (size_t i = 0; i < BucketCount; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      Timestamp upper = i == 0 ? 0 : (i == 64 ? max : (Timestamp(1) << i) - 1);
+      return std::clamp(upper, getMin(), max);
+    }
+  }
+  return max;
+}
+
+std::string LatencyHistogram::toString() const {
+  std::stringstream ss;
+  ss << "Latency: " << count << " events, mean " << getMean() / 1000
+     << "us, p99 " << getPercentile(99) / 1000 << "us, max " << max / 1000
+     << "us";
+  return ss.str();
+}
+
+} // namespace Trundle
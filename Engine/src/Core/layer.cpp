@@ -30,10 +30,65 @@ void Layer::onDetach() {}
 
 void Layer::onUpdate() {}
 
+void Layer::onUpdate(Timestep) { onUpdate(); }
+
+void Layer::onRender(float) {}
+
 void Layer::onEvent(Event&) {}
 
 const std::string& Layer::getName() {
     return name;
 }
 
+bool Layer::isSubscribed(EventType type) const {
+  return subscriptions & (1u << static_cast<uint32_t>(type));
+}
+
+bool Layer::hasDependencies() const {
+  return declared;
+}
+
+const std::vector<std::string>& Layer::getReads() const {
+  return readSet;
+}
+
+const std::vector<std::string>& Layer::getWrites() const {
+  return writeSet;
+}
+
+const std::vector<std::string>& Layer::getRunsAfter() const {
+  return afterSet;
+}
+
+void Layer::subscribe(EventType type) {
+  if (!subscribed) {
+    subscriptions = 0;
+    subscribed = true;
+  }
+  subscriptions |= 1u << static_cast<uint32_t>(type);
+}
+
+void Layer::subscribe(EventCategory category) {
+  for (size_t i = 0; i < EventTypeCount; ++i) {
+    auto type = static_cast<EventType>(i);
+    if ((getEventCategory(type) & category) != EventCategory::None) {
+      subscribe(type);
+    }
+  }
+}
+
+void Layer::reads(const std::string& resource) {
+  readSet.push_back(resource);
+  declared = true;
+}
+
+void Layer::writes(const std::string& resource) {
+  writeSet.push_back(resource);
+  declared = true;
+}
+
+void Layer::runsAfter(const std::string& layer) {
+  afterSet.push_back(layer);
+}
+
 } // namespace Trundle
\ No newline at end of file
@@ -16,39 +16,222 @@
 //
 //===----------------------------------------------------------------------===//
 #include <Trundle/Core/layerStack.h>
+#include <Trundle/Core/log.h>
 
 namespace Trundle {
 
+namespace {
+
+// Checks if two layers can not be updated at the same time.
+bool conflicts(const Layer* a, const Layer* b) {
+  if (!a->hasDependencies() || !b->hasDependencies()) {
+    return true;
+  }
+
+  auto overlaps = [](const std::vector<std::string>& lhs,
+                     const std::vector<std::string>& rhs) {
+    for (const std::string& resource : lhs) {
+      if (std::find(rhs.begin(), rhs.end(), resource) != rhs.end()) {
+        return true;
+      }
+    }
+    return false;
+  };
+  return overlaps(a->getWrites(), b->getWrites()) ||
+         overlaps(a->getWrites(), b->getReads()) ||
+         overlaps(a->getReads(), b->getWrites());
+}
+
+} // namespace
+
 LayerStack::LayerStack() 
   : layers{}, it{0} {}
 
 LayerStack::~LayerStack() {}
 
-void LayerStack::pushLayer(Ref<Layer> layer) {
-  layers.insert(layers.begin() + it, layer);
-  ++it;
-  layer->onAttach();
+LayerHandle LayerStack::pushLayer(Ref<Layer> layer) {
+  return push(std::move(layer), CommandType::PushLayer);
 }
 
-void LayerStack::pushOverlay(Ref<Layer> overlay) {
-  layers.push_back(overlay);
-  overlay->onAttach();
+LayerHandle LayerStack::pushOverlay(Ref<Layer> overlay) {
+  return push(std::move(overlay), CommandType::PushOverlay);
 }
 
 void LayerStack::popLayer(Ref<Layer> layer) {
-  auto findIt = std::find(layers.begin(), layers.end(), layer);
-  if (findIt != layers.end()) {
-    layers.erase(findIt);
-    --it;
-    layer->onDetach();
+  LayerHandle handle;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto slot = slotOf.find(layer.get());
+    if (slot == slotOf.end()) {
+      return;
+    }
+    handle = {slot->second, slots[slot->second].generation};
   }
+  pop(handle);
 }
 
 void LayerStack::popOverlay(Ref<Layer> overlay) {
-  auto findIt = std::find(layers.begin(), layers.end(), overlay);
-  if (findIt != layers.end()) {
-    layers.erase(findIt);
-    overlay->onDetach();
+  popLayer(std::move(overlay));
+}
+
+void LayerStack::pop(LayerHandle handle) {
+  if (get(handle) != nullptr) {
+    request({CommandType::Pop, handle});
+  }
+}
+
+Layer* LayerStack::get(LayerHandle handle) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (handle.index >= slots.size() ||
+      slots[handle.index].generation != handle.generation) {
+    return nullptr;
+  }
+  return slots[handle.index].layer;
+}
+
+void LayerStack::beginTraversal() {
+  std::lock_guard<std::mutex> lock(mutex);
+  ++traversals;
+}
+
+void LayerStack::endTraversal() {
+  std::lock_guard<std::mutex> lock(mutex);
+  assert(traversals > 0 && "Error: No traversal to end.");
+  --traversals;
+}
+
+void LayerStack::applyPending() {
+  // Layers may push and pop others when they are attached or detached, which
+  // is applied straight away, so take the queue before walking it.
+  std::vector<Command> commands;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (traversals > 0) {
+      return;
+    }
+    commands.swap(pending);
+  }
+  for (const Command& command : commands) {
+    apply(command);
+  }
+}
+
+LayerHandle LayerStack::push(Ref<Layer> layer, CommandType type) {
+  assert(layer && "Error: Pushing a null layer.");
+
+  LayerHandle handle;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    // A layer whose pop is queued can be pushed again, for example to move it
+    // to the top of the stack during a traversal.
+    assert((slotOf.count(layer.get()) == 0 ||
+            slots[slotOf.at(layer.get())].popQueued) &&
+           "Error: The layer is already in the stack.");
+
+    uint32_t index;
+    if (freeSlots.empty()) {
+      index = static_cast<uint32_t>(slots.size());
+      slots.emplace_back();
+    } else {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+    }
+    slotOf[layer.get()] = index;
+    slots[index].layer = layer.get();
+    slots[index].pending = std::move(layer);
+    slots[index].position = NoPosition;
+    handle = {index, slots[index].generation};
+  }
+  request({type, handle});
+  return handle;
+}
+
+void LayerStack::request(const Command& command) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (traversals > 0) {
+      if (command.type == CommandType::Pop) {
+        slots[command.handle.index].popQueued = true;
+      }
+      pending.push_back(command);
+      return;
+    }
+  }
+  apply(command);
+}
+
+void LayerStack::apply(const Command& command) {
+  Layer* layer;
+  Ref<Layer> owner;
+  size_t position;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    Slot& slot = slots[command.handle.index];
+    if (slot.generation != command.handle.generation) {
+      // The layer was popped more than once.
+      return;
+    }
+    layer = slot.layer;
+    owner = std::move(slot.pending);
+    position = slot.position;
+
+    if (command.type == CommandType::Pop) {
+      // The layer may have been pushed again into another slot since.
+      auto current = slotOf.find(layer);
+      if (current != slotOf.end() && current->second == command.handle.index) {
+        slotOf.erase(current);
+      }
+      slot.layer = nullptr;
+      slot.popQueued = false;
+      ++slot.generation;
+      freeSlots.push_back(command.handle.index);
+    }
+  }
+
+  // The lock is not held from here on, as attaching and detaching layers may
+  // push and pop other layers.
+  switch (command.type) {
+  case CommandType::PushLayer:
+    layers.insert(layers.begin() + it, std::move(owner));
+    layerSlots.insert(layerSlots.begin() + it, command.handle.index);
+    updatePositions(it);
+    ++it;
+    updateViews();
+    layer->onAttach();
+    break;
+
+  case CommandType::PushOverlay:
+    layers.push_back(std::move(owner));
+    layerSlots.push_back(command.handle.index);
+    updatePositions(layers.size() - 1);
+    updateViews();
+    layer->onAttach();
+    break;
+
+  case CommandType::Pop:
+    // A layer that is popped before its push was applied is not in the stack.
+    if (position != NoPosition) {
+      // Only layers below the overlays move the boundary between them.
+      if (position < it) {
+        --it;
+      }
+      // Keep the layer alive until it has been detached.
+      owner = std::move(layers[position]);
+      layers.erase(layers.begin() + position);
+      layerSlots.erase(layerSlots.begin() + position);
+      updatePositions(position);
+    }
+
+    updateViews();
+    layer->onDetach();
+    break;
+  }
+}
+
+void LayerStack::updatePositions(size_t first) {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (size_t position = first; position < layers.size(); ++position) {
+    slots[layerSlots[position]].position = position;
   }
 }
 
@@ -60,6 +243,104 @@ std::vector<Ref<Layer>>::reverse_iterator LayerStack::end() {
   return layers.rend();
 }
 
+const std::vector<Layer*>& LayerStack::getLayers() const {
+  return view;
+}
+
+const std::vector<std::vector<Layer*>>& LayerStack::getUpdateLevels() const {
+  return levels;
+}
+
+const std::vector<Layer*>& LayerStack::getSubscribers(EventType type) const {
+  return subscribers[static_cast<size_t>(type)];
+}
+
+void LayerStack::updateViews() {
+  view.clear();
+  for (auto layer = layers.rbegin(); layer != layers.rend(); ++layer) {
+    view.push_back(layer->get());
+  }
+
+  for (size_t i = 0; i < EventTypeCount; ++i) {
+    auto type = static_cast<EventType>(i);
+    auto& list = subscribers[i];
+    list.clear();
+    for (Layer* layer : view) {
+      if (layer->isSubscribed(type)) {
+        list.push_back(layer);
+      }
+    }
+  }
+
+  updateLevels();
+}
+
+void LayerStack::updateLevels() {
+  size_t count = view.size();
+
+  // Order the layers by their runsAfter declarations, keeping the stack order
+  // wherever they do not say otherwise.
+  std::vector<std::vector<size_t>> after(count);
+  std::vector<size_t> incoming(count, 0);
+  for (size_t to = 0; to < count; ++to) {
+    for (const std::string& name : view[to]->getRunsAfter()) {
+      for (size_t from = 0; from < count; ++from) {
+        if (from != to && view[from]->getName() == name) {
+          after[from].push_back(to);
+          ++incoming[to];
+        }
+      }
+    }
+  }
+
+  std::vector<Layer*> order;
+  std::vector<bool> placed(count, false);
+  while (order.size() < count) {
+    size_t next = 0;
+    while (next < count && (placed[next] || incoming[next] != 0)) {
+      ++next;
+    }
+    if (next == count) {
+      // There is no order that satisfies every declaration, so fall back to
+      // updating the layers one at a time in stack order.
+      Log::Error("The runsAfter declarations of the layers form a cycle, "
+                 "updating every layer on its own");
+      levels.clear();
+      for (Layer* layer : view) {
+        levels.push_back({layer});
+      }
+      return;
+    }
+
+    placed[next] = true;
+    order.push_back(view[next]);
+    for (size_t to : after[next]) {
+      --incoming[to];
+    }
+  }
+
+  // Place each layer one level below the deepest layer before it that it
+  // conflicts with or must run after.
+  std::vector<size_t> depth(count, 0);
+  size_t levelCount = 0;
+  for (size_t to = 0; to < count; ++to) {
+    const auto& names = order[to]->getRunsAfter();
+    for (size_t from = 0; from < to; ++from) {
+      if (conflicts(order[from], order[to]) ||
+          std::find(names.begin(), names.end(), order[from]->getName()) !=
+              names.end()) {
+        depth[to] = std::max(depth[to], depth[from] + 1);
+      }
+    }
+    levelCount = std::max(levelCount, depth[to] + 1);
+  }
+
+  levels.assign(levelCount, {});
+  for (size_t i = 0; i < count; ++i) {
+    levels[depth[i]].push_back(order[i]);
+  }
+}
+
 size_t LayerStack::size() {
   return layers.size();
 }
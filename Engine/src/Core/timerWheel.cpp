@@ -0,0 +1,208 @@
+//===-- timerWheel.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Core/timerWheel.h>
+
+#include <Trundle/Core/bits.h>
+
+namespace Trundle {
+
+TimerWheel::TimerWheel(Timestamp now, Timestamp resolution)
+  : resolution(resolution), current(now / resolution) {
+  assert(resolution > 0 && "Error: Timer resolution must not be 0.");
+  for (auto& level : levels) {
+    level.slots.fill(None);
+  }
+}
+
+TimerHandle TimerWheel::schedule(Timestamp deadline, uint32_t code,
+                                 Timestamp period) {
+  uint32_t index;
+  if (freeList != None) {
+    index = freeList;
+    freeList = nodes[index].next;
+  } else {
+    index = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+  }
+
+  Node& node = nodes[index];
+  // A timer that is already due fires on the next tick.
+  node.deadline = std::max(toTick(deadline), current + 1);
+  node.period = period == 0 ? 0 : std::max<uint64_t>(toTick(period), 1);
+  node.code = code;
+  insert(index);
+  ++count;
+  return TimerHandle{index, node.generation};
+}
+
+bool TimerWheel::cancel(TimerHandle handle) {
+  if (!isPending(handle)) {
+    return false;
+  }
+  unlink(handle.index);
+  release(handle.index);
+  --count;
+  return true;
+}
+
+bool TimerWheel::isPending(TimerHandle handle) const {
+  return handle.index < nodes.size() &&
+         nodes[handle.index].generation == handle.generation &&
+         nodes[handle.index].slot != None;
+}
+
+void TimerWheel::advance(Timestamp now, std::vector<Expired>& expired) {
+  // Only ticks that have fully passed are processed.
+  uint64_t target = now / resolution;
+  while (current < target) {
+    if (count == 0) {
+      current = target;
+      break;
+    }
+
+    // Skip straight to the next slot boundary of the lowest occupied level,
+    // nothing can fire or move between here and there.
+    uint64_t next = current + 1;
+    for (uint32_t level = 0; level < LevelCount - 1; ++level) {
+      if (levels[level].occupied != 0) {
+        break;
+      }
+      uint32_t bits = LevelBits * (level + 1);
+      next = (current | ((uint64_t(1) << bits) - 1)) + 1;
+    }
+    current = std::min(next, target);
+
+    // Move timers down from every level whose slot boundary has been
+    // reached, coarsest first, so they can keep falling to the lowest level.
+    for (uint32_t level = LevelCount - 1; level > 0; --level) {
+      uint32_t bits = LevelBits * level;
+      if ((current & ((uint64_t(1) << bits) - 1)) == 0) {
+        cascade(level,
+                static_cast<uint32_t>(current >> bits) & (SlotCount - 1));
+      }
+    }
+
+    // Fire every timer in the slot of the current tick.
+    uint32_t slot = static_cast<uint32_t>(current) & (SlotCount - 1);
+    uint32_t index = levels[0].slots[slot];
+    while (index != None) {
+      uint32_t following = nodes[index].next;
+      Node& node = nodes[index];
+      expired.push_back({TimerHandle{index, node.generation}, node.code});
+      unlink(index);
+      if (node.period != 0) {
+        node.deadline += node.period;
+        insert(index);
+      } else {
+        release(index);
+        --count;
+      }
+      index = following;
+    }
+  }
+}
+
+Timestamp TimerWheel::getNextWake() const {
+  // Timers are always in a slot after the current one in their level, and
+  // every slot of a level starts after every slot of the level below it.
+  for (uint32_t level = 0; level < LevelCount && count != 0; ++level) {
+    uint32_t bits = LevelBits * level;
+    uint32_t currentSlot = static_cast<uint32_t>(current >> bits) &
+                           (SlotCount - 1);
+    uint64_t later = currentSlot == SlotCount - 1
+                         ? 0
+                         : levels[level].occupied &
+                               (~uint64_t(0) << (currentSlot + 1));
+    if (later == 0) {
+      continue;
+    }
+
+    // The tick at the start of the first occupied slot.
+    uint64_t slot = static_cast<uint64_t>(countTrailingZeros(later));
+    uint64_t base = bits + LevelBits >= 64
+                        ? 0
+                        : current >> (bits + LevelBits) << (bits + LevelBits);
+    return (base + (slot << bits)) * resolution;
+  }
+  return ~Timestamp(0);
+}
+
+uint64_t TimerWheel::toTick(Timestamp time) const {
+  return time / resolution + (time % resolution != 0);
+}
+
+void TimerWheel::insert(uint32_t index) {
+  Node& node = nodes[index];
+  uint64_t difference = node.deadline ^ current;
+  uint32_t level =
+      difference < SlotCount
+          ? 0
+          : static_cast<uint32_t>(63 - countLeadingZeros(difference)) /
+                LevelBits;
+  uint32_t slot = static_cast<uint32_t>(node.deadline >> (LevelBits * level)) &
+                  (SlotCount - 1);
+
+  Level& target = levels[level];
+  node.slot = level * SlotCount + slot;
+  node.prev = None;
+  node.next = target.slots[slot];
+  if (node.next != None) {
+    nodes[node.next].prev = index;
+  }
+  target.slots[slot] = index;
+  target.occupied |= uint64_t(1) << slot;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+  Node& node = nodes[index];
+  Level& level = levels[node.slot / SlotCount];
+  uint32_t slot = node.slot % SlotCount;
+
+  if (node.prev != None) {
+    nodes[node.prev].next = node.next;
+  } else {
+    level.slots[slot] = node.next;
+  }
+  if (node.next != None) {
+    nodes[node.next].prev = node.prev;
+  }
+  if (level.slots[slot] == None) {
+    level.occupied &= ~(uint64_t(1) << slot);
+  }
+  node.slot = None;
+}
+
+void TimerWheel::release(uint32_t index) {
+  Node& node = nodes[index];
+  ++node.generation;
+  node.next = freeList;
+  freeList = index;
+}
+
+void TimerWheel::cascade(uint32_t level, uint32_t slot) {
+  uint32_t index = levels[level].slots[slot];
+  levels[level].slots[slot] = None;
+  levels[level].occupied &= ~(uint64_t(1) << slot);
+  while (index != None) {
+    uint32_t following = nodes[index].next;
+    insert(index);
+    index = following;
+  }
+}
+
+} // namespace Trundle
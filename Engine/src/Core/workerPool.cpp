@@ -0,0 +1,107 @@
+//===-- workerPool.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Core/workerPool.h>
+
+namespace Trundle {
+
+WorkerPool::WorkerPool(size_t workers) {
+  threads.reserve(workers);
+  for (size_t i = 0; i < workers; ++i) {
+    threads.emplace_back(&WorkerPool::work, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  started.notify_all();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+void WorkerPool::run(size_t count,
+                     const std::function<void(size_t)>& task) {
+  // There is nothing to gain from waking the threads for a single task.
+  if (threads.empty() || count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    // A thread woken by the last batch may not have noticed it has ended.
+    finished.wait(lock, [this] { return active == 0; });
+    this->task = &task;
+    this->count = count;
+    next.store(0, std::memory_order_relaxed);
+    remaining = count;
+    ++batch;
+  }
+  started.notify_all();
+
+  size_t done = drain();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  remaining -= done;
+  finished.wait(lock, [this] { return remaining == 0 && active == 0; });
+  this->task = nullptr;
+}
+
+size_t WorkerPool::size() const {
+  return threads.size() + 1;
+}
+
+void WorkerPool::work() {
+  uint64_t seen = 0;
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    started.wait(lock, [&] { return stopping || batch != seen; });
+    if (stopping) {
+      return;
+    }
+    seen = batch;
+
+    ++active;
+    lock.unlock();
+    size_t done = drain();
+    lock.lock();
+    --active;
+
+    remaining -= done;
+    if (remaining == 0 && active == 0) {
+      finished.notify_one();
+    }
+  }
+}
+
+size_t WorkerPool::drain() {
+  size_t done = 0;
+  size_t index;
+  while ((index = next.fetch_add(1, std::memory_order_relaxed)) < count) {
+    (*task)(index);
+    ++done;
+  }
+  return done;
+}
+
+} // namespace Trundle
@@ -0,0 +1,70 @@
+//===-- eventArena.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Events/eventArena.h>
+
+namespace Trundle {
+
+EventArena::EventArena() {
+  blocks.push_back(std::make_unique<Block>());
+  events.reserve(256);
+}
+
+EventArena::~EventArena() { reset(); }
+
+void EventArena::reset() {
+  for (Event* event : events) {
+    event->~Event();
+  }
+  events.clear();
+  currentBlock = 0;
+  offset = 0;
+}
+
+std::vector<Event*>::const_iterator EventArena::begin() const {
+  return events.begin();
+}
+
+std::vector<Event*>::const_iterator EventArena::end() const {
+  return events.end();
+}
+
+size_t EventArena::size() const {
+  return events.size();
+}
+
+size_t EventArena::capacity() const {
+  return blocks.size() * blockSize;
+}
+
+void* EventArena::allocate(size_t size, size_t alignment) {
+  size_t start = (offset + alignment - 1) & ~(alignment - 1);
+  if (start + size > blockSize) {
+    // Move on to the next block, only hitting the heap if the arena has never
+    // needed this many blocks before.
+    ++currentBlock;
+    if (currentBlock == blocks.size()) {
+      blocks.push_back(std::make_unique<Block>());
+    }
+    start = 0;
+  }
+
+  offset = start + size;
+  return blocks[currentBlock]->data + start;
+}
+
+} // namespace Trundle
@@ -0,0 +1,79 @@
+//===-- eventData.cpp -----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Events/eventData.h>
+
+namespace Trundle {
+
+EventData toEventData(const Event& event) {
+  switch (event.getEventType()) {
+  case EventType::None:
+    return NoneData{};
+
+  case EventType::KeyPress: {
+    const auto& e = static_cast<const KeyPressEvent&>(event);
+    return KeyPressData{e.getKeyCode(), e.isRepeatEvent()};
+  }
+
+  case EventType::KeyRelease:
+    return KeyReleaseData{
+        static_cast<const KeyReleaseEvent&>(event).getKeyCode()};
+
+  case EventType::MousePress:
+    return MousePressData{
+        static_cast<const MousePressEvent&>(event).getMouseCode()};
+
+  case EventType::MouseRelease:
+    return MouseReleaseData{
+        static_cast<const MouseReleaseEvent&>(event).getMouseCode()};
+
+  case EventType::MouseMove: {
+    const auto& e = static_cast<const MouseMoveEvent&>(event);
+    auto [x, y] = e.getPosition();
+    auto [dx, dy] = e.getDelta();
+    return MouseMoveData{x, y, dx, dy};
+  }
+
+  case EventType::MouseScroll: {
+    auto [x, y] = static_cast<const MouseScrollEvent&>(event).getOffset();
+    return MouseScrollData{x, y};
+  }
+
+  case EventType::WindowClose:
+    return WindowCloseData{};
+
+  case EventType::WindowResize: {
+    auto [w, h] = static_cast<const WindowResizeEvent&>(event).getSize();
+    return WindowResizeData{w, h};
+  }
+
+  case EventType::Timer: {
+    const auto& e = static_cast<const TimerEvent&>(event);
+    return TimerData{e.getHandle(), e.getCode()};
+  }
+
+  case EventType::User: {
+    const auto& e = static_cast<const UserEvent&>(event);
+    return UserData{e.getCode(), e.getPayload()};
+  }
+  }
+
+  assert(0 && "Error: Unknown event type.");
+  return NoneData{};
+}
+
+} // namespace Trundle
@@ -0,0 +1,157 @@
+//===-- eventLog.cpp ------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Events/eventLog.h>
+
+#include <cstring>
+
+namespace Trundle {
+
+namespace {
+
+// Copies the payload of a record into the alternative of EventData at Index.
+template <size_t Index>
+EventData loadAlternative(const EventRecord& record) {
+  using Data = std::variant_alternative_t<Index, EventData>;
+  static_assert(sizeof(Data) <= sizeof(record.payload),
+                "Event payload does not fit in an EventRecord");
+  Data data;
+  std::memcpy(&data, record.payload, sizeof(Data));
+  return data;
+}
+
+template <size_t... Index>
+EventData loadPayload(const EventRecord& record,
+                      std::index_sequence<Index...>) {
+  // A table of loaders indexed by the type of the record.
+  using Loader = EventData (*)(const EventRecord&);
+  static constexpr Loader loaders[] = {&loadAlternative<Index>...};
+  if (record.type >= sizeof...(Index)) {
+    return NoneData{};
+  }
+  return loaders[record.type](record);
+}
+
+} // namespace
+
+EventRecord toEventRecord(const EventData& event, uint64_t timestamp,
+                          uint64_t frame) {
+  EventRecord record{};
+  record.timestamp = timestamp;
+  record.frame = frame;
+  record.type = static_cast<uint32_t>(event.index());
+  std::visit(
+      [&record](const auto& data) {
+        static_assert(sizeof(data) <= sizeof(record.payload),
+                      "Event payload does not fit in an EventRecord");
+        std::memcpy(record.payload, &data, sizeof(data));
+      },
+      event);
+  return record;
+}
+
+EventRecord toUpdateRecord(Timestamp step, uint64_t timestamp,
+                           uint64_t frame) {
+  EventRecord record{};
+  record.timestamp = timestamp;
+  record.frame = frame;
+  record.type = UpdateRecordType;
+  std::memcpy(record.payload, &step, sizeof(step));
+  return record;
+}
+
+Timestamp getUpdateStep(const EventRecord& record) {
+  assert(record.type == UpdateRecordType &&
+         "Error: The record is not an update.");
+  Timestamp step;
+  std::memcpy(&step, record.payload, sizeof(step));
+  return step;
+}
+
+EventData toEventData(const EventRecord& record) {
+  return loadPayload(record, std::make_index_sequence<EventTypeCount>());
+}
+
+bool EventRecorder::open(const std::string& path) {
+  close();
+  file.open(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  EventLogHeader header{};
+  std::memcpy(header.magic, EventLogMagic, sizeof(header.magic));
+  header.version = EventLogVersion;
+  header.recordSize = sizeof(EventRecord);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  start = getTimestamp();
+  count = 0;
+  return true;
+}
+
+void EventRecorder::close() {
+  if (file.is_open()) {
+    file.close();
+  }
+}
+
+void EventRecorder::record(const EventData& event, Timestamp timestamp,
+                           uint64_t frame) {
+  // Events made before the log was opened, or by the application, are placed
+  // at the start of the log.
+  Timestamp elapsed = timestamp > start ? timestamp - start : 0;
+  EventRecord record = toEventRecord(event, elapsed, frame);
+  file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+  ++count;
+}
+
+void EventRecorder::recordUpdate(Timestamp step, uint64_t frame) {
+  Timestamp now = getTimestamp();
+  EventRecord record = toUpdateRecord(step, now > start ? now - start : 0,
+                                      frame);
+  file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+  ++count;
+}
+
+EventLog::EventLog(const std::string& path) : file(path) {
+  if (!file.isOpen() || file.getSize() < sizeof(EventLogHeader)) {
+    return;
+  }
+
+  EventLogHeader header;
+  std::memcpy(&header, file.getData(), sizeof(header));
+  valid = std::memcmp(header.magic, EventLogMagic, sizeof(header.magic)) == 0 &&
+          header.version == EventLogVersion &&
+          header.recordSize == sizeof(EventRecord);
+  if (valid) {
+    // A trailing partial record, left by a crash while recording, is ignored.
+    count = (file.getSize() - sizeof(header)) / sizeof(EventRecord);
+  }
+}
+
+EventRecord EventLog::operator[](size_t index) const {
+  assert(index < count && "Error: Event record index out of range.");
+  EventRecord record;
+  std::memcpy(&record,
+              file.getData() + sizeof(EventLogHeader) +
+                  index * sizeof(EventRecord),
+              sizeof(record));
+  return record;
+}
+
+} // namespace Trundle
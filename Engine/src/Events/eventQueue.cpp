@@ -0,0 +1,55 @@
+//===-- eventQueue.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Events/eventQueue.h>
+
+namespace Trundle {
+
+EventQueue::EventQueue() {}
+
+EventQueue::~EventQueue() {}
+
+std::vector<Event*>::const_iterator EventQueue::begin() const {
+  return arena.begin();
+}
+
+std::vector<Event*>::const_iterator EventQueue::end() const {
+  return arena.end();
+}
+
+size_t EventQueue::size() const {
+  return arena.size();
+}
+
+bool EventQueue::empty() const {
+  return arena.size() == 0;
+}
+
+void EventQueue::clear() {
+  arena.reset();
+  latest.fill(nullptr);
+}
+
+void EventQueue::setCoalescing(bool enable) {
+  coalescing = enable;
+}
+
+bool EventQueue::isCoalescing() const {
+  return coalescing;
+}
+
+} // namespace Trundle
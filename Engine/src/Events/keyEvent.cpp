@@ -33,10 +33,6 @@ int KeyEvent::getKeyCode() const {
 KeyPressEvent::KeyPressEvent(int keyCode, bool repeatEvent)
 : KeyEvent(keyCode), repeatEvent(repeatEvent) {}
 
-EventType KeyPressEvent::getStaticType() { 
-  return EventType::KeyPress;
-}
-
 EventType KeyPressEvent::getEventType() const { 
   return getStaticType();
 }
@@ -52,6 +48,10 @@ std::string KeyPressEvent::toString() const {
      << (repeatEvent ? "" : "not ") << "a repeated event";
   return ss.str();
 }
+
+bool KeyPressEvent::isRepeatEvent() const {
+  return repeatEvent;
+}
 //===----------------------------------------------------------------------===//
 
 
@@ -59,10 +59,6 @@ std::string KeyPressEvent::toString() const {
 KeyReleaseEvent::KeyReleaseEvent(int keyCode)
 : KeyEvent(keyCode) {}
 
-EventType KeyReleaseEvent::getStaticType() {
-  return EventType::KeyRelease; 
-}
-
 EventType KeyReleaseEvent::getEventType() const { 
   return getStaticType();
 }
@@ -33,10 +33,6 @@ int MouseButtonEvent::getMouseCode() const {
 MousePressEvent::MousePressEvent(int mouseCode)
 : MouseButtonEvent(mouseCode) {}
 
-EventType MousePressEvent::getStaticType() { 
-  return EventType::MousePress;
-}
-
 EventType MousePressEvent::getEventType() const { 
   return getStaticType();
 }
@@ -58,10 +54,6 @@ std::string MousePressEvent::toString() const {
 MouseReleaseEvent::MouseReleaseEvent(int mouseCode)
 : MouseButtonEvent(mouseCode) {}
 
-EventType MouseReleaseEvent::getStaticType() { 
-  return EventType::MouseRelease;
-}
-
 EventType MouseReleaseEvent::getEventType() const { 
   return getStaticType();
 }
@@ -80,12 +72,8 @@ std::string MouseReleaseEvent::toString() const {
 
 
 //===-- MouseMoveEvent ----------------------------------------------------===//
-MouseMoveEvent::MouseMoveEvent(double x, double y)
-: x(x), y(y) {}
-
-EventType MouseMoveEvent::getStaticType() { 
-  return EventType::MouseMove;
-}
+MouseMoveEvent::MouseMoveEvent(double x, double y, double dx, double dy)
+: x(x), y(y), dx(dx), dy(dy) {}
 
 EventType MouseMoveEvent::getEventType() const { 
   return getStaticType();
@@ -105,6 +93,48 @@ std::string MouseMoveEvent::toString() const {
 std::tuple<double, double> MouseMoveEvent::getPosition() const {
   return {x, y};
 }
+
+std::tuple<double, double> MouseMoveEvent::getDelta() const {
+  return {dx, dy};
+}
+
+void MouseMoveEvent::coalesce(const MouseMoveEvent& later) {
+  x = later.x;
+  y = later.y;
+  dx += later.dx;
+  dy += later.dy;
+}
+//===----------------------------------------------------------------------===//
+
+
+//===-- MouseScrollEvent --------------------------------------------------===//
+MouseScrollEvent::MouseScrollEvent(double xOffset, double yOffset)
+: xOffset(xOffset), yOffset(yOffset) {}
+
+EventType MouseScrollEvent::getEventType() const { 
+  return getStaticType();
+}
+
+const char* MouseScrollEvent::getName() const { 
+  return "MouseScroll";
+}
+
+std::string MouseScrollEvent::toString() const {
+  // TODO: Replace with something better than a stringstream.
+  std::stringstream ss;
+  ss << "Recieved MouseScrollEvent with offset (" << xOffset << ", "
+     << yOffset << ")";
+  return ss.str();
+}
+
+std::tuple<double, double> MouseScrollEvent::getOffset() const {
+  return {xOffset, yOffset};
+}
+
+void MouseScrollEvent::coalesce(const MouseScrollEvent& later) {
+  xOffset += later.xOffset;
+  yOffset += later.yOffset;
+}
 //===----------------------------------------------------------------------===//
 
 } // namespace Trundle
\ No newline at end of file
@@ -0,0 +1,51 @@
+//===-- timerEvent.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Events/timerEvent.h>
+
+namespace Trundle {
+
+//===-- TimerEvent --------------------------------------------------------===//
+TimerEvent::TimerEvent(TimerHandle handle, uint32_t code)
+: handle(handle), code(code) {}
+
+EventType TimerEvent::getEventType() const { 
+  return getStaticType();
+}
+
+const char* TimerEvent::getName() const { 
+  return "Timer";
+}
+
+std::string TimerEvent::toString() const {
+  // TODO: Replace with something better than a stringstream.
+  std::stringstream ss;
+  ss << "Recieved TimerEvent for timer " << handle.index << " with code "
+     << code;
+  return ss.str();
+}
+
+TimerHandle TimerEvent::getHandle() const {
+  return handle;
+}
+
+uint32_t TimerEvent::getCode() const {
+  return code;
+}
+//===----------------------------------------------------------------------===//
+
+} // namespace Trundle
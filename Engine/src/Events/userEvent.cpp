@@ -0,0 +1,50 @@
+//===-- userEvent.cpp -----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Events/userEvent.h>
+
+namespace Trundle {
+
+//===-- UserEvent ---------------------------------------------------------===//
+UserEvent::UserEvent(uint32_t code, uint64_t payload)
+: code(code), payload(payload) {}
+
+EventType UserEvent::getEventType() const { 
+  return getStaticType();
+}
+
+const char* UserEvent::getName() const { 
+  return "User";
+}
+
+std::string UserEvent::toString() const {
+  // TODO: Replace with something better than a stringstream.
+  std::stringstream ss;
+  ss << "Recieved UserEvent with code " << code << " and payload " << payload;
+  return ss.str();
+}
+
+uint32_t UserEvent::getCode() const {
+  return code;
+}
+
+uint64_t UserEvent::getPayload() const {
+  return payload;
+}
+//===----------------------------------------------------------------------===//
+
+} // namespace Trundle
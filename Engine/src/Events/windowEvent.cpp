@@ -22,10 +22,6 @@ namespace Trundle {
 //===-- WindowCloseEvent ---------------------------------------------------===//
 WindowCloseEvent::WindowCloseEvent() {}
 
-EventType WindowCloseEvent::getStaticType() { 
-  return EventType::WindowClose;
-}
-
 EventType WindowCloseEvent::getEventType() const { 
   return getStaticType();
 }
@@ -44,10 +40,6 @@ std::string WindowCloseEvent::toString() const {
 WindowResizeEvent::WindowResizeEvent(int w, int h)
 : width(w), height(h) {}
 
-EventType WindowResizeEvent::getStaticType() { 
-  return EventType::WindowResize;
-}
-
 EventType WindowResizeEvent::getEventType() const { 
   return getStaticType();
 }
@@ -63,6 +55,15 @@ std::string WindowResizeEvent::toString() const {
      << height;
   return ss.str();
 }
+
+std::tuple<int, int> WindowResizeEvent::getSize() const {
+  return {width, height};
+}
+
+void WindowResizeEvent::coalesce(const WindowResizeEvent& later) {
+  width = later.width;
+  height = later.height;
+}
 //===----------------------------------------------------------------------===//
 
 } // namespace Trundle
\ No newline at end of file
@@ -0,0 +1,59 @@
+//===-- gamepad.cpp -------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// The Linux implementation for reading gamepads.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Platform/Linux/gamepad.h>
+
+#include <GLFW/glfw3.h>
+
+namespace Trundle {
+
+static_assert(GLFW_GAMEPAD_BUTTON_LAST + 1 == GamepadButtonCount,
+              "GamepadButton must match the GLFW gamepad buttons");
+static_assert(GLFW_GAMEPAD_AXIS_LAST + 1 == GamepadAxisCount,
+              "GamepadAxis must match the GLFW gamepad axes");
+
+// Creates a new Linux gamepad source when create is called.
+GamepadSource* GamepadSource::create() {
+  return new LinuxGamepadSource();
+}
+
+bool LinuxGamepadSource::read(size_t id, GamepadState& state) {
+  assert(id < GamepadCount && "Error: Not a gamepad.");
+  int joystick = GLFW_JOYSTICK_1 + static_cast<int>(id);
+
+  GLFWgamepadstate gamepad;
+  if (!glfwJoystickIsGamepad(joystick) ||
+      !glfwGetGamepadState(joystick, &gamepad)) {
+    return false;
+  }
+
+  state.buttons = 0;
+  for (size_t button = 0; button < GamepadButtonCount; ++button) {
+    state.buttons |= uint32_t(gamepad.buttons[button] == GLFW_PRESS)
+                     << button;
+  }
+  for (size_t axis = 0; axis < GamepadAxisCount; ++axis) {
+    state.axes[axis] = gamepad.axes[axis];
+  }
+  return true;
+}
+
+} // namespace Trundle
@@ -0,0 +1,59 @@
+//===-- mappedFile.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// The MacOS implementation of a memory mapped file.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Core/mappedFile.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Trundle {
+
+MappedFile::MappedFile(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      data = static_cast<const unsigned char*>(mapping);
+      size = static_cast<size_t>(info.st_size);
+      // The file is read front to back, so let the kernel read ahead.
+      madvise(mapping, size, MADV_SEQUENTIAL);
+    }
+  }
+
+  // The mapping keeps its own reference to the file.
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data) {
+    munmap(const_cast<unsigned char*>(data), size);
+  }
+}
+
+} // namespace Trundle
@@ -16,10 +16,12 @@
 //
 //===----------------------------------------------------------------------===//
 #include <Trundle/Core/log.h>
+#include <Trundle/Events/eventQueue.h>
 #include <Trundle/Events/keyEvent.h>
 #include <Trundle/Events/mouseEvent.h>
 #include <Trundle/Events/windowEvent.h>
 #include <Trundle/Platform/MacOS/window.h>
+#include <Trundle/Util/input.h>
 
 namespace Trundle {
 
@@ -76,67 +78,71 @@ void MacOSWindow::init(const WindowProperties& properties) {
 
   glfwSetWindowUserPointer(window, &data);
 
-  // Set callbacks from glfw.
-  // TODO: Convert raw pointers to smart pointers.
-  //       Add modifiers to events.
+  // Set callbacks from glfw. Events are appended to the window's queue so
+  // that the application can handle the whole frame's input in one pass.
+  // TODO: Add modifiers to events.
   glfwSetKeyCallback(window, [](GLFWwindow* window, int key, int /*scancode*/,
                                 int action, int /*mods*/) {
     void* userPointer = glfwGetWindowUserPointer(window);
     WindowData* data = (WindowData*)userPointer;
 
-    Event* event;
     switch (action) {
     case GLFW_PRESS:
-      event = new KeyPressEvent(key, false);
+      data->events.push<KeyPressEvent>(key, false);
       break;
 
     case GLFW_REPEAT:
-      event = new KeyPressEvent(key, true);
+      data->events.push<KeyPressEvent>(key, true);
       break;
 
     case GLFW_RELEASE:
-      event = new KeyReleaseEvent(key);
+      data->events.push<KeyReleaseEvent>(key);
       break;
 
     default:
       assert(0 && "Unreachable");
     }
-
-    data->callback(*event);
-    delete event;
   });
 
   glfwSetCursorPosCallback(window, [](GLFWwindow* window, double x, double y) {
     void* userPointer = glfwGetWindowUserPointer(window);
     WindowData* data = (WindowData*)userPointer;
 
-    Event* event = new MouseMoveEvent(x, y);
-    data->callback(*event);
-    delete event;
+    // Measure how far the cursor moved from the last sample.
+    double dx = data->cursorTracked ? x - data->cursorX : 0;
+    double dy = data->cursorTracked ? y - data->cursorY : 0;
+    data->cursorX = x;
+    data->cursorY = y;
+    data->cursorTracked = true;
+
+    data->events.push<MouseMoveEvent>(x, y, dx, dy);
   });
 
+  glfwSetScrollCallback(
+      window, [](GLFWwindow* window, double xOffset, double yOffset) {
+        void* userPointer = glfwGetWindowUserPointer(window);
+        WindowData* data = (WindowData*)userPointer;
+
+        data->events.push<MouseScrollEvent>(xOffset, yOffset);
+      });
+
   glfwSetMouseButtonCallback(
       window, [](GLFWwindow* window, int button, int action, int /*mod*/) {
         void* userPointer = glfwGetWindowUserPointer(window);
         WindowData* data = (WindowData*)userPointer;
 
-        Event* event;
-
         switch (action) {
         case GLFW_PRESS:
-          event = new MousePressEvent(button);
+          data->events.push<MousePressEvent>(button);
           break;
 
         case GLFW_RELEASE:
-          event = new MouseReleaseEvent(button);
+          data->events.push<MouseReleaseEvent>(button);
           break;
 
         default:
           assert(0 && "Unreachable");
         };
-
-        data->callback(*event);
-        delete event;
       });
 
   glfwSetWindowSizeCallback(
@@ -147,27 +153,36 @@ void MacOSWindow::init(const WindowProperties& properties) {
         data->width = width;
         data->height = height;
 
-        Event* event = new WindowResizeEvent(width, height);
-        data->callback(*event);
-        delete event;
+        data->events.push<WindowResizeEvent>(width, height);
       });
 
   glfwSetWindowCloseCallback(window, [](GLFWwindow* window) {
     void* userPointer = glfwGetWindowUserPointer(window);
     WindowData* data = (WindowData*)userPointer;
 
-    Event* event = new WindowCloseEvent();
-    data->callback(*event);
-    delete event;
+    data->events.push<WindowCloseEvent>();
   });
 }
 
 void MacOSWindow::shutdown() { glfwDestroyWindow(window); }
 
-void MacOSWindow::onUpdate() {
-  // Check for events.
-  //Log::Warn("Hello");
+void MacOSWindow::pollEvents() {
   glfwPollEvents();
+}
+
+void MacOSWindow::waitEvents(Timestamp timeout) {
+  glfwWaitEventsTimeout(static_cast<double>(timeout) / 1e9);
+}
+
+void MacOSWindow::wake() {
+  glfwPostEmptyEvent();
+}
+
+EventQueue& MacOSWindow::getEventQueue() {
+  return data.events;
+}
+
+void MacOSWindow::onUpdate() {
   glfwSwapBuffers(window);
 }
 
@@ -179,10 +194,6 @@ uint32_t MacOSWindow::getHeight() {
   return data.height; 
 }
 
-void MacOSWindow::setEventCallback(const EventCallback& callback) {
-  data.callback = callback;
-}
-
 void MacOSWindow::setVSync(bool enable) {
   if (enable) {
     glfwSwapInterval(1);
@@ -194,6 +205,33 @@ void MacOSWindow::setVSync(bool enable) {
 
 bool MacOSWindow::isVSync() const { return data.vSync; }
 
+bool MacOSWindow::setRawMouseMotion(bool enable) {
+  if (enable && !glfwRawMouseMotionSupported()) {
+    return false;
+  }
+
+  glfwSetInputMode(window, GLFW_CURSOR,
+                   enable ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+  glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION,
+                   enable ? GLFW_TRUE : GLFW_FALSE);
+  data.rawMouseMotion = enable;
+
+  // The cursor jumps when it is captured or released, so don't report that
+  // jump as motion.
+  data.cursorTracked = false;
+  return true;
+}
+
+bool MacOSWindow::isRawMouseMotion() const { return data.rawMouseMotion; }
+
+bool MacOSWindow::isKeyPressed(KeyCode keycode) const {
+  int key = TrundleToGL(keycode);
+  if (key == GLFW_KEY_UNKNOWN) {
+    return false;
+  }
+  return glfwGetKey(window, key) == GLFW_PRESS;
+}
+
 void* MacOSWindow::getNativeWindow() const { return (void*)window; }
 
 } // namespace Trundle
\ No newline at end of file
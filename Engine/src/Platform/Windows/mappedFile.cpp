@@ -0,0 +1,61 @@
+//===-- mappedFile.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+/// The Windows implementation of a memory mapped file.
+//
+//===----------------------------------------------------------------------===//
+#include <Trundle/Core/mappedFile.h>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+namespace Trundle {
+
+MappedFile::MappedFile(const std::string& path) {
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+
+  LARGE_INTEGER fileSize;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping) {
+      void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      if (view) {
+        data = static_cast<const unsigned char*>(view);
+        size = static_cast<size_t>(fileSize.QuadPart);
+      }
+      // The view keeps its own reference to the mapping.
+      CloseHandle(mapping);
+    }
+  }
+
+  CloseHandle(file);
+}
+
+MappedFile::~MappedFile() {
+  if (data) {
+    UnmapViewOfFile(data);
+  }
+}
+
+} // namespace Trundle
@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <iostream>
+#include <future>
 
 class LayerA : public Trundle::Layer {
 public:
@@ -103,4 +104,112 @@ TEST_F(Application, OverlayPoping) {
   stackTop = *layerStack.begin();
   ASSERT_TRUE(overlay2 == stackTop)
     << "Top overlay layer was removed";
-}
\ No newline at end of file
+}
+
+TEST_F(Application, IndependentInstances) {
+  // Headless applications packed onto threads of one process must not share
+  // their input.
+  struct Watcher : public Trundle::Layer {
+    Trundle::KeyCode key{Trundle::KeyCode::None};
+    Trundle::Application* owner{nullptr};
+    int frames{0};
+    int mismatches{0};
+    void onUpdate() override {
+      ++frames;
+      bool ownKeyOnly = Trundle::Input::isKeyDown(key);
+      Trundle::Input::handleKeysDown([&](Trundle::KeyCode down) {
+        ownKeyOnly &= down == key;
+      });
+      if (!ownKeyOnly || Trundle::Application::get() != owner) {
+        ++mismatches;
+      }
+    }
+  };
+  struct Simulation : public Trundle::Application {
+    Simulation() : Trundle::Application(true) {}
+    using Trundle::Application::run;
+  };
+
+  constexpr int ThreadCount = 8;
+  constexpr int FrameCount = 100;
+  std::vector<std::shared_ptr<Watcher>> watchers;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < ThreadCount; ++i) {
+    watchers.push_back(std::make_shared<Watcher>());
+  }
+  for (int i = 0; i < ThreadCount; ++i) {
+    threads.emplace_back([i, watcher = watchers[i]]() {
+      Simulation simulation;
+      watcher->key = static_cast<Trundle::KeyCode>(
+          static_cast<int>(Trundle::KeyCode::A) + i);
+      watcher->owner = &simulation;
+      simulation.pushLayer(watcher);
+
+      // GLFW key codes for A to H are contiguous.
+      simulation.run(std::make_shared<Trundle::KeyPressEvent>(65 + i, false));
+      auto tick = std::make_shared<Trundle::UserEvent>(0, 0);
+      for (int frame = 1; frame < FrameCount; ++frame) {
+        simulation.run(tick);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& watcher : watchers) {
+    EXPECT_EQ(FrameCount, watcher->frames);
+    EXPECT_EQ(0, watcher->mismatches)
+      << "Applications on different threads shared their input";
+  }
+  EXPECT_EQ(this, Trundle::Application::get())
+    << "Other threads changed the current application of this thread";
+}
+
+TEST_F(Application, PrimaryOnOtherThreads) {
+  // A thread that never ran an application, such as a loader thread, falls
+  // back to the first application of the process and its input.
+  run(std::make_shared<Trundle::UserEvent>(0, 0));
+  ASSERT_NE(0u, getInput().getSnapshot().frame);
+
+  Trundle::Application* seen = nullptr;
+  Trundle::InputContext* context = nullptr;
+  Trundle::InputSnapshot snapshot;
+  std::thread loader([&]() {
+    seen = Trundle::Application::get();
+    context = &Trundle::Input::getContext();
+    snapshot = Trundle::Input::getSnapshot();
+  });
+  loader.join();
+  EXPECT_EQ(this, seen);
+  EXPECT_EQ(&getInput(), context);
+  EXPECT_EQ(getInput().getSnapshot().frame, snapshot.frame);
+}
+
+TEST_F(Application, DestroyedOnAnotherThread) {
+  // A thread that ran an application constructed elsewhere must not keep
+  // using it once it is destroyed.
+  struct Simulation : public Trundle::Application {
+    Simulation() : Trundle::Application(true) {}
+    using Trundle::Application::run;
+  };
+  auto simulation = std::make_unique<Simulation>();
+  std::promise<void> ran;
+  std::promise<void> destroyed;
+  Trundle::Application* seen = nullptr;
+  Trundle::InputContext* context = nullptr;
+  std::thread server([&, destroyedFuture = destroyed.get_future()]() {
+    simulation->run(std::make_shared<Trundle::UserEvent>(0, 0));
+    ran.set_value();
+    destroyedFuture.wait();
+    seen = Trundle::Application::get();
+    context = &Trundle::Input::getContext();
+  });
+  ran.get_future().wait();
+  simulation.reset();
+  destroyed.set_value();
+  server.join();
+
+  EXPECT_EQ(this, seen) << "The thread kept a destroyed application";
+  EXPECT_EQ(&getInput(), context) << "The thread kept a destroyed input";
+}
@@ -46,11 +46,138 @@ TEST_F(Events, KeyPressEvent) {
   ASSERT_TRUE(event->handled) << "KeyPressEvent was not handled";  
 }
 
+TEST_F(Events, UnknownKey) {
+  // GLFW reports keys it has no code for, such as media keys, as -1.
+  run(std::make_shared<Trundle::KeyPressEvent>(-1, false));
+  EXPECT_FALSE(Trundle::Input::isKeyDown(Trundle::KeyCode::None))
+    << "An unknown key was registered as held";
+  int held = 0;
+  Trundle::Input::handleKeysDown([&held](Trundle::KeyCode) { ++held; });
+  EXPECT_EQ(0, held);
+  EXPECT_TRUE(getInput().getSnapshot().keysDown.none());
+
+  run(std::make_shared<Trundle::KeyReleaseEvent>(-1));
+  EXPECT_TRUE(getInput().getSnapshot().keysReleased.none())
+    << "An unknown key was registered as released";
+}
+
 TEST_F(Events, KeyReleaseEvent) {
   auto event = std::make_shared<Trundle::KeyReleaseEvent>(GLFW_KEY_A);
   run(event);
   ASSERT_TRUE(event->handled) << "KeyReleaseEvent was not handled";
 }
+
+TEST_F(Events, IsKeyPressedHeadless) {
+  run(std::make_shared<Trundle::KeyPressEvent>(GLFW_KEY_A, false));
+  EXPECT_TRUE(Trundle::Input::isKeyPressed(Trundle::KeyCode::A))
+    << "isKeyPressed should not need a window";
+
+  // Reconciliation needs a window, so headless it should change nothing.
+  setKeyReconciliation(true);
+  run(std::make_shared<Trundle::UserEvent>(0, 0));
+  EXPECT_TRUE(Trundle::Input::isKeyPressed(Trundle::KeyCode::A));
+  setKeyReconciliation(false);
+
+  run(std::make_shared<Trundle::KeyReleaseEvent>(GLFW_KEY_A));
+  EXPECT_FALSE(Trundle::Input::isKeyPressed(Trundle::KeyCode::A));
+}
+
+TEST_F(Events, PreviouslyUnmappedKeys) {
+  // Hard coded GLFW key codes for Backspace, Tab and Keypad 5.
+  std::vector<std::pair<int, Trundle::KeyCode>> keys = {
+    {259, Trundle::KeyCode::Backspace},
+    {258, Trundle::KeyCode::Tab},
+    {325, Trundle::KeyCode::Keypad5}};
+  for (auto [glfwKey, key] : keys) {
+    run(std::make_shared<Trundle::KeyPressEvent>(glfwKey, false));
+    EXPECT_TRUE(Trundle::Input::isKeyDown(key))
+      << "GLFW key " << glfwKey << " was not converted";
+    run(std::make_shared<Trundle::KeyReleaseEvent>(glfwKey));
+    EXPECT_TRUE(Trundle::Input::isKeyUp(key));
+  }
+}
+
+TEST_F(Events, KeyPressedThisFrame) {
+  struct Watcher : public Trundle::Layer {
+    std::vector<bool> pressed;
+    void onUpdate() override {
+      pressed.push_back(
+          Trundle::Input::wasPressedThisFrame(Trundle::KeyCode::A));
+    }
+  };
+  auto watcher = std::make_shared<Watcher>();
+  pushLayer(watcher);
+
+  auto press = std::make_shared<Trundle::KeyPressEvent>(GLFW_KEY_A, false);
+  auto repeat = std::make_shared<Trundle::KeyPressEvent>(GLFW_KEY_A, true);
+  auto release = std::make_shared<Trundle::KeyReleaseEvent>(GLFW_KEY_A);
+  run({press, repeat, release});
+
+  std::vector<bool> expected = {true, false, false};
+  EXPECT_EQ(expected, watcher->pressed)
+    << "Layers should see a key as pressed only in the frame it went down";
+  popLayer(watcher);
+}
+
+TEST_F(Events, RepeatAndReleaseInOneFrame) {
+  // A key held since an earlier frame that repeats and is then released
+  // within one frame was only released, not pressed again.
+  run(std::make_shared<Trundle::KeyPressEvent>(GLFW_KEY_A, false));
+  ASSERT_TRUE(Trundle::Input::wasPressedThisFrame(Trundle::KeyCode::A));
+  updateLayers();
+
+  Trundle::EventQueue queue;
+  queue.push<Trundle::KeyPressEvent>(GLFW_KEY_A, true);
+  queue.push<Trundle::KeyReleaseEvent>(GLFW_KEY_A);
+  processEvents(queue);
+  updateLayers();
+  EXPECT_FALSE(Trundle::Input::wasPressedThisFrame(Trundle::KeyCode::A))
+    << "A repeat should not be reported as a new press";
+  EXPECT_TRUE(Trundle::Input::wasReleasedThisFrame(Trundle::KeyCode::A));
+}
+
+TEST_F(Events, InputHistory) {
+  auto press = std::make_shared<Trundle::KeyPressEvent>(GLFW_KEY_A, false);
+  auto release = std::make_shared<Trundle::KeyReleaseEvent>(GLFW_KEY_A);
+  run({press, release});
+
+  const auto& history = getInputHistory();
+  uint64_t frame = history.getNewestFrame();
+  ASSERT_GE(history.size(), 2u);
+  EXPECT_TRUE(history.wasReleased(frame, Trundle::KeyCode::A))
+    << "The history should hold a record of every frame";
+  ASSERT_NE(nullptr, history.get(frame - 1));
+  EXPECT_TRUE(history.get(frame - 1)->keysDown.test(
+      static_cast<size_t>(Trundle::KeyCode::A)));
+}
+
+TEST_F(Events, InputActions) {
+  auto& actions = getInputActions();
+  Trundle::ActionId jump = actions.addAction("Jump");
+  actions.bind(jump, {Trundle::KeyCode::A});
+
+  struct Watcher : public Trundle::Layer {
+    Trundle::ActionId jump{0};
+    std::vector<bool> pressed;
+    void onUpdate() override {
+      pressed.push_back(
+          Trundle::Application::get()->getInputActions().wasPressed(jump));
+    }
+  };
+  auto watcher = std::make_shared<Watcher>();
+  watcher->jump = jump;
+  pushLayer(watcher);
+
+  auto press = std::make_shared<Trundle::KeyPressEvent>(GLFW_KEY_A, false);
+  auto repeat = std::make_shared<Trundle::KeyPressEvent>(GLFW_KEY_A, true);
+  auto release = std::make_shared<Trundle::KeyReleaseEvent>(GLFW_KEY_A);
+  run({press, repeat, release});
+
+  std::vector<bool> expected = {true, false, false};
+  EXPECT_EQ(expected, watcher->pressed)
+    << "Actions should be resolved before the layers are updated";
+  popLayer(watcher);
+}
 //===----------------------------------------------------------------------===//
 
 //===-- Mouse Events -----------------------------------------------------===//
@@ -71,6 +198,41 @@ TEST_F(Events, MouseMoveEvent) {
   run(event);
   ASSERT_TRUE(event->handled) << "MouseMoveEvent was not handled";
 }
+
+TEST_F(Events, MouseScrollEvent) {
+  auto event = std::make_shared<Trundle::MouseScrollEvent>(0, 1);
+  run(event);
+  ASSERT_TRUE(event->handled) << "MouseScrollEvent was not handled";
+}
+
+TEST_F(Events, MouseDeltaPerFrame) {
+  // Many small moves within a frame should add up to the same motion as one
+  // large move, no matter how the cursor was sampled.
+  Trundle::EventQueue queue;
+  for (int i = 1; i <= 4; ++i) {
+    queue.push<Trundle::MouseMoveEvent>(i * 2.5, 0, 2.5, -1);
+  }
+  queue.push<Trundle::MouseScrollEvent>(0, 1);
+  queue.push<Trundle::MouseScrollEvent>(0, 1);
+  processEvents(queue);
+  updateLayers();
+
+  auto [dx, dy] = Trundle::Input::getMouseDelta();
+  EXPECT_DOUBLE_EQ(10.0, dx);
+  EXPECT_DOUBLE_EQ(-4.0, dy);
+  auto [sx, sy] = Trundle::Input::getScrollDelta();
+  EXPECT_DOUBLE_EQ(0.0, sx);
+  EXPECT_DOUBLE_EQ(2.0, sy);
+  auto [x, y] = Trundle::Input::getMousePosition();
+  EXPECT_DOUBLE_EQ(10.0, x);
+
+  updateLayers();
+  auto [nextDx, nextDy] = Trundle::Input::getMouseDelta();
+  EXPECT_DOUBLE_EQ(0.0, nextDx) << "Mouse delta was carried into next frame";
+  EXPECT_DOUBLE_EQ(0.0, nextDy) << "Mouse delta was carried into next frame";
+  EXPECT_FALSE(setRawMouseMotion(true))
+    << "Raw mouse motion needs a window";
+}
 //===----------------------------------------------------------------------===//
 
 //===-- Window Events -----------------------------------------------------===//
@@ -85,4 +247,328 @@ TEST_F(Events, DISABLED_WindowResizeEvent) {
   run(event);
   ASSERT_TRUE(event->handled) << "WindowResizeEvent was not handled";
 }
-//===----------------------------------------------------------------------===//
\ No newline at end of file
+//===----------------------------------------------------------------------===//
+//===-- Event Queue -------------------------------------------------------===//
+TEST_F(Events, ProcessEvents) {
+  Trundle::EventQueue queue;
+  queue.push<Trundle::KeyPressEvent>(GLFW_KEY_A, false);
+  queue.push<Trundle::MouseMoveEvent>(10, 10);
+  queue.push<Trundle::KeyReleaseEvent>(GLFW_KEY_A);
+
+  processEvents(queue);
+  EXPECT_EQ(3u, getEventQueueDepth())
+    << "Queue depth was not recorded";
+  EXPECT_TRUE(queue.empty())
+    << "Queue was not cleared after being processed";
+}
+
+TEST_F(Events, ProcessEventsOrdering) {
+  struct Recorder : public Trundle::Layer {
+    std::vector<Trundle::EventType> seen;
+    void onEvent(Trundle::Event& event) override {
+      seen.push_back(event.getEventType());
+    }
+  };
+  auto recorder = std::make_shared<Recorder>();
+  pushLayer(recorder);
+
+  // Resize events are not handled by the engine so they reach the layers.
+  Trundle::EventQueue queue;
+  queue.push<Trundle::WindowResizeEvent>(1, 1);
+  queue.push<Trundle::KeyPressEvent>(GLFW_KEY_A, false);
+  queue.push<Trundle::WindowResizeEvent>(2, 2);
+  processEvents(queue);
+
+  ASSERT_EQ(2u, recorder->seen.size())
+    << "Unhandled events were not passed to the layer";
+  EXPECT_EQ(Trundle::EventType::WindowResize, recorder->seen[0]);
+  EXPECT_EQ(Trundle::EventType::WindowResize, recorder->seen[1]);
+  EXPECT_EQ(3u, getEventQueueDepth());
+  popLayer(recorder);
+}
+//===----------------------------------------------------------------------===//
+
+//===-- Posted Events -----------------------------------------------------===//
+TEST_F(Events, PostEvent) {
+  struct Recorder : public Trundle::Layer {
+    uint64_t payload{0};
+    void onEvent(Trundle::Event& event) override {
+      if (event.getEventType() == Trundle::EventType::User) {
+        payload = static_cast<Trundle::UserEvent&>(event).getPayload();
+        event.handled = true;
+      }
+    }
+  };
+  auto recorder = std::make_shared<Recorder>();
+  pushLayer(recorder);
+
+  ASSERT_TRUE(postEvent(Trundle::UserData{1, 42}))
+    << "Event could not be posted";
+  processPostedEvents();
+  EXPECT_EQ(42u, recorder->payload)
+    << "Posted event was not passed to the layer";
+  popLayer(recorder);
+}
+
+TEST_F(Events, PostEventFromThreads) {
+  struct Counter : public Trundle::Layer {
+    std::vector<uint64_t> received;
+    void onEvent(Trundle::Event& event) override {
+      if (event.getEventType() == Trundle::EventType::User) {
+        auto& user = static_cast<Trundle::UserEvent&>(event);
+        ++received[user.getCode()];
+        event.handled = true;
+      }
+    }
+  };
+  constexpr uint32_t threadCount = 8;
+  constexpr uint64_t perThread = 20000;
+  auto counter = std::make_shared<Counter>();
+  counter->received.resize(threadCount, 0);
+  pushLayer(counter);
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < threadCount; ++t) {
+    threads.emplace_back([this, t]() {
+      for (uint64_t i = 0; i < perThread; ++i) {
+        while (!postEvent(Trundle::UserData{t, i})) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Drain on this thread as the main loop would while the workers post.
+  uint64_t total = 0;
+  while (total < threadCount * perThread) {
+    processPostedEvents();
+    total = 0;
+    for (auto count : counter->received) {
+      total += count;
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (uint32_t t = 0; t < threadCount; ++t) {
+    EXPECT_EQ(perThread, counter->received[t])
+      << "Events from thread " << t << " were lost";
+  }
+  popLayer(counter);
+}
+//===----------------------------------------------------------------------===//
+
+//===-- Event Log ---------------------------------------------------------===//
+TEST_F(Events, RecordAndReplay) {
+  struct Recorder : public Trundle::Layer {
+    std::vector<std::tuple<int, int>> sizes;
+    int updates{0};
+    void onUpdate() override { ++updates; }
+    void onEvent(Trundle::Event& event) override {
+      if (event.getEventType() == Trundle::EventType::WindowResize) {
+        sizes.push_back(
+            static_cast<Trundle::WindowResizeEvent&>(event).getSize());
+      }
+    }
+  };
+  std::string path = testing::TempDir() + "events_record_and_replay.log";
+
+  ASSERT_TRUE(startRecording(path))
+    << "Event log could not be created";
+  Trundle::EventQueue queue;
+  queue.push<Trundle::WindowResizeEvent>(1, 1);
+  queue.push<Trundle::WindowResizeEvent>(2, 2);
+  processEvents(queue);
+  updateLayers();
+  queue.push<Trundle::WindowResizeEvent>(3, 3);
+  processEvents(queue);
+  stopRecording();
+
+  auto recorder = std::make_shared<Recorder>();
+  pushLayer(recorder);
+  EXPECT_EQ(3u, replay(path))
+    << "Not every recorded event was replayed";
+  ASSERT_EQ(3u, recorder->sizes.size());
+  EXPECT_EQ(std::make_tuple(1, 1), recorder->sizes[0]);
+  EXPECT_EQ(std::make_tuple(2, 2), recorder->sizes[1]);
+  EXPECT_EQ(std::make_tuple(3, 3), recorder->sizes[2]);
+  EXPECT_EQ(2, recorder->updates)
+    << "Layers should be updated once per recorded frame";
+  popLayer(recorder);
+  std::remove(path.c_str());
+}
+
+TEST_F(Events, ReplayVariableSteps) {
+  struct Stepper : public Trundle::Layer {
+    std::vector<Trundle::Timestep> steps;
+    void onUpdate(Trundle::Timestep step) override { steps.push_back(step); }
+  };
+  constexpr Trundle::Timestamp Millisecond = 1000000;
+  std::string path = testing::TempDir() + "events_replay_variable_steps.log";
+  auto clock = std::make_shared<Trundle::ManualClock>();
+  setClock(clock);
+  auto stepper = std::make_shared<Stepper>();
+  pushLayer(stepper);
+
+  ASSERT_TRUE(startRecording(path));
+  Trundle::EventQueue queue;
+  for (Trundle::Timestamp frame : {16, 17, 33}) {
+    clock->advance(frame * Millisecond);
+    queue.push<Trundle::WindowResizeEvent>(1, 1);
+    processEvents(queue);
+    updateFrame();
+  }
+  stopRecording();
+  std::vector<Trundle::Timestep> recorded = stepper->steps;
+  ASSERT_EQ(3u, recorded.size());
+
+  stepper->steps.clear();
+  EXPECT_EQ(3u, replay(path));
+  EXPECT_EQ(recorded, stepper->steps)
+    << "Replay should update the layers with the recorded steps";
+  popLayer(stepper);
+  std::remove(path.c_str());
+}
+
+TEST_F(Events, ReplayTimersAndPostedEvents) {
+  struct Watcher : public Trundle::Layer {
+    std::vector<Trundle::EventType> types;
+    int connectedUpdates{0};
+    void onUpdate() override {
+      connectedUpdates += Trundle::Gamepads::isConnected(0);
+    }
+    void onEvent(Trundle::Event& event) override {
+      types.push_back(event.getEventType());
+    }
+  };
+  std::string path = testing::TempDir() + "events_replay_timers.log";
+  auto clock = std::make_shared<Trundle::ManualClock>();
+  setClock(clock);
+  auto gamepads = std::make_shared<Trundle::ManualGamepadSource>();
+  gamepads->setConnected(0, true);
+  getInput().getGamepads().setSource(gamepads);
+  auto watcher = std::make_shared<Watcher>();
+  pushLayer(watcher);
+
+  ASSERT_TRUE(startRecording(path));
+  constexpr Trundle::Timestamp Millisecond = 1000000;
+  scheduleTimer(Millisecond, 1);
+  clock->advance(2 * Millisecond);
+  processTimers();
+  ASSERT_TRUE(postEvent(Trundle::UserData{2, 0}));
+  processPostedEvents();
+  updateLayers();
+  stopRecording();
+  std::vector<Trundle::EventType> recorded = watcher->types;
+  ASSERT_EQ(2u, recorded.size());
+  EXPECT_EQ(1, watcher->connectedUpdates);
+
+  // Timers that would fire during the replay come from the log instead.
+  scheduleTimer(0, 3);
+  watcher->types.clear();
+  watcher->connectedUpdates = 0;
+  EXPECT_EQ(2u, replay(path)) << "Timer and posted events were not recorded";
+  EXPECT_EQ(recorded, watcher->types);
+  EXPECT_EQ(0, watcher->connectedUpdates)
+    << "Replay should not read the live gamepads";
+  EXPECT_TRUE(getInput().getGamepads().getSource() == gamepads)
+    << "The gamepads were not restored after the replay";
+  popLayer(watcher);
+  std::remove(path.c_str());
+}
+
+TEST_F(Events, InputLatency) {
+  Trundle::EventQueue queue;
+  queue.push<Trundle::KeyPressEvent>(GLFW_KEY_A, false);
+  queue.push<Trundle::WindowResizeEvent>(1, 1);
+  processEvents(queue);
+  updateLayers();
+  present();
+
+  const auto& handling = getHandlingLatency();
+  const auto& presented = getPresentLatency();
+  EXPECT_EQ(2u, handling.getCount())
+    << "Every window event should have its handling latency recorded";
+  EXPECT_EQ(2u, presented.getCount())
+    << "Every window event should have its present latency recorded";
+  EXPECT_LE(handling.getMax(), presented.getMax())
+    << "Events cannot be presented before they are handled";
+
+  // Events made by the application carry no arrival time.
+  run(std::make_shared<Trundle::WindowResizeEvent>(1, 1));
+  EXPECT_EQ(0u, getPresentLatency().getCount())
+    << "Latency should only be reported for the last frame";
+}
+
+TEST_F(Events, ReplayMissingLog) {
+  EXPECT_EQ(0u, replay(testing::TempDir() + "events_missing.log"))
+    << "Replaying a missing log should not handle any events";
+}
+//===----------------------------------------------------------------------===//
+
+//===-- Timers ------------------------------------------------------------===//
+TEST_F(Events, Timers) {
+  struct Recorder : public Trundle::Layer {
+    std::vector<uint32_t> codes;
+    void onEvent(Trundle::Event& event) override {
+      if (event.getEventType() == Trundle::EventType::Timer) {
+        codes.push_back(static_cast<Trundle::TimerEvent&>(event).getCode());
+        event.handled = true;
+      }
+    }
+  };
+  constexpr Trundle::Timestamp Millisecond = 1000000;
+  auto clock = std::make_shared<Trundle::ManualClock>();
+  setClock(clock);
+  auto recorder = std::make_shared<Recorder>();
+  pushLayer(recorder);
+
+  scheduleTimer(250 * Millisecond, 1);
+  auto periodic = scheduleTimer(100 * Millisecond, 2, 100 * Millisecond);
+  auto cancelled = scheduleTimer(50 * Millisecond, 3);
+  EXPECT_TRUE(cancelTimer(cancelled));
+
+  // Run three 100ms frames.
+  auto event = std::make_shared<Trundle::WindowResizeEvent>(1, 1);
+  for (int frame = 0; frame < 3; ++frame) {
+    clock->advance(100 * Millisecond);
+    run(event);
+  }
+
+  std::vector<uint32_t> expected = {2, 2, 1, 2};
+  EXPECT_EQ(expected, recorder->codes)
+    << "Timers did not fire through onEvent as scheduled";
+  EXPECT_TRUE(cancelTimer(periodic));
+  popLayer(recorder);
+}
+//===----------------------------------------------------------------------===//
+
+//===-- Gamepads ----------------------------------------------------------===//
+TEST_F(Events, Gamepads) {
+  struct Watcher : public Trundle::Layer {
+    std::vector<bool> pressed;
+    void onUpdate() override {
+      pressed.push_back(Trundle::Gamepads::wasPressedThisFrame(
+          0, Trundle::GamepadButton::A));
+    }
+  };
+  auto source = std::make_shared<Trundle::ManualGamepadSource>();
+  Trundle::Gamepads::setSource(source);
+  auto watcher = std::make_shared<Watcher>();
+  pushLayer(watcher);
+
+  auto event = std::make_shared<Trundle::UserEvent>(0, 0);
+  source->setConnected(0, true);
+  run(event);
+  source->setButton(0, Trundle::GamepadButton::A, true);
+  run(event);
+  run(event);
+
+  std::vector<bool> expected = {false, true, false};
+  EXPECT_EQ(expected, watcher->pressed)
+    << "Gamepads should be polled once before the layers are updated";
+  popLayer(watcher);
+  Trundle::Gamepads::setSource(nullptr);
+}
+//===----------------------------------------------------------------------===//
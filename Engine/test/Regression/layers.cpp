@@ -41,6 +41,11 @@ public:
   bool onEventCalled{false};
 };
 
+class WindowLayer : public LayerA {
+public:
+  WindowLayer() { subscribe(Trundle::EventCategory::WindowEvent); }
+};
+
 class Layers : public Trundle::Application, public testing::Test {
 public:
   Layers()
@@ -121,4 +126,175 @@ TEST_F(Layers, GetName) {
   auto layer = std::make_shared<LayerA>();
   EXPECT_EQ(std::string("LayerA"), layer->getName())
     << "Layer name was miss labeled";
-}
\ No newline at end of file
+}
+
+TEST_F(Layers, Subscriptions) {
+  auto layer = std::make_shared<WindowLayer>();
+  auto user = std::make_shared<Trundle::UserEvent>(1);
+  auto resize = std::make_shared<Trundle::WindowResizeEvent>(1,1);
+
+  pushLayer(layer);
+  run(user);
+  EXPECT_FALSE(layer->onEventCalled)
+    << "onEvent() was called for an event the layer did not subscribe to";
+  run(resize);
+  EXPECT_TRUE(layer->onEventCalled)
+    << "onEvent() was not called for a subscribed event";
+  popLayer(layer);
+}
+
+TEST_F(Layers, PushAndPopWhileUpdating) {
+  // A layer that replaces itself with another the first time it is updated.
+  struct Spawner : public LayerA {
+    void onUpdate() override {
+      if (++updates == 1) {
+        app->pushLayer(child);
+        app->popLayer(selfHandle);
+      }
+    }
+
+    Trundle::Application* app{nullptr};
+    Trundle::Ref<LayerA> child{std::make_shared<LayerA>()};
+    Trundle::LayerHandle selfHandle;
+    int updates{0};
+  };
+  auto spawner = std::make_shared<Spawner>();
+  spawner->app = this;
+  spawner->selfHandle = pushLayer(spawner);
+
+  updateLayers();
+  EXPECT_FALSE(spawner->child->onUpdateCalled)
+    << "A layer pushed during onUpdate should wait for the next frame";
+  EXPECT_TRUE(spawner->child->onAttachCalled)
+    << "Changes should be applied at the end of the frame";
+  EXPECT_TRUE(spawner->onDetachCalled);
+
+  updateLayers();
+  EXPECT_TRUE(spawner->child->onUpdateCalled);
+  EXPECT_EQ(1, spawner->updates) << "Popped layer was still updated";
+  EXPECT_EQ(nullptr, layerStack.get(spawner->selfHandle));
+  popLayer(spawner->child);
+}
+
+TEST_F(Layers, ParallelUpdates) {
+  // Each producer writes its own counter, and the consumer runs after all of
+  // them and reads their totals.
+  struct Producer : public Trundle::Layer {
+    Producer(const std::string& name) : Layer(name) { writes(name); }
+    void onUpdate() override {
+      ++count;
+      sawApplication = Trundle::Application::get() == app;
+    }
+
+    Trundle::Application* app{nullptr};
+    int count{0};
+    bool sawApplication{false};
+  };
+  struct Consumer : public Trundle::Layer {
+    Consumer(const std::vector<Trundle::Ref<Producer>>& producers)
+      : Layer("Consumer"), producers(producers) {
+      for (const auto& producer : producers) {
+        reads(producer->getName());
+      }
+    }
+    void onUpdate() override {
+      total = 0;
+      for (const auto& producer : producers) {
+        total += producer->count;
+      }
+    }
+
+    std::vector<Trundle::Ref<Producer>> producers;
+    int total{0};
+  };
+
+  std::vector<Trundle::Ref<Producer>> producers;
+  for (int i = 0; i < 8; ++i) {
+    producers.push_back(
+        std::make_shared<Producer>("Producer" + std::to_string(i)));
+    producers.back()->app = this;
+  }
+  auto consumer = std::make_shared<Consumer>(producers);
+  pushLayer(consumer);
+  for (const auto& producer : producers) {
+    pushLayer(producer);
+  }
+
+  setUpdateThreads(4);
+  EXPECT_EQ(4u, getUpdateThreads());
+  ASSERT_EQ(2u, layerStack.getUpdateLevels().size());
+  EXPECT_EQ(8u, layerStack.getUpdateLevels()[0].size());
+
+  for (int frame = 1; frame <= 50; ++frame) {
+    updateLayers();
+    EXPECT_EQ(8 * frame, consumer->total)
+      << "The consumer ran before the producers had finished";
+  }
+  for (const auto& producer : producers) {
+    EXPECT_EQ(50, producer->count);
+    EXPECT_TRUE(producer->sawApplication)
+      << "Layers updated on a worker should see their application";
+  }
+
+  setUpdateThreads(1);
+  EXPECT_EQ(1u, getUpdateThreads());
+  updateLayers();
+  EXPECT_EQ(8 * 51, consumer->total);
+
+  for (const auto& producer : producers) {
+    popLayer(producer);
+  }
+  popLayer(consumer);
+}
+
+TEST_F(Layers, FixedTimestep) {
+  // Records the steps and alphas that the layer is given.
+  struct Stepper : public Trundle::Layer {
+    void onUpdate(Trundle::Timestep step) override { steps.push_back(step); }
+    void onRender(float value) override { alphas.push_back(value); }
+
+    std::vector<Trundle::Timestep> steps;
+    std::vector<float> alphas;
+  };
+  constexpr Trundle::Timestamp Millisecond = 1000000;
+  auto clock = std::make_shared<Trundle::ManualClock>();
+  setClock(clock);
+  auto stepper = std::make_shared<Stepper>();
+  pushLayer(stepper);
+  auto event = std::make_shared<Trundle::UserEvent>(1);
+
+  // Without a fixed timestep there is one update per frame with the time
+  // since the last frame.
+  clock->advance(5 * Millisecond);
+  run(event);
+  ASSERT_EQ(1u, stepper->steps.size());
+  EXPECT_EQ(Trundle::Timestep(5 * Millisecond), stepper->steps[0]);
+  EXPECT_EQ(1.0f, stepper->alphas.back());
+
+  setFixedTimestep(100);
+  EXPECT_EQ(Trundle::Timestep(10 * Millisecond), getFixedTimestep());
+  stepper->steps.clear();
+
+  clock->advance(5 * Millisecond);
+  run(event);
+  EXPECT_TRUE(stepper->steps.empty()) << "Updated before a step had passed";
+  EXPECT_FLOAT_EQ(0.5f, stepper->alphas.back());
+
+  clock->advance(30 * Millisecond);
+  run(event);
+  EXPECT_EQ(3u, stepper->steps.size())
+    << "Should update once for every whole step that has passed";
+  for (auto step : stepper->steps) {
+    EXPECT_EQ(getFixedTimestep(), step);
+  }
+  EXPECT_FLOAT_EQ(0.5f, stepper->alphas.back());
+  EXPECT_FLOAT_EQ(0.5f, getInterpolationAlpha());
+
+  clock->advance(10000 * Millisecond);
+  run(event);
+  EXPECT_EQ(28u, stepper->steps.size())
+    << "A long stall should be limited to 250ms of updates";
+
+  setFixedTimestep(0);
+  popLayer(stepper);
+}
@@ -0,0 +1,80 @@
+//===-- bitSet.cpp --------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/bitSet.h>
+
+TEST(BitSet, DefaultConstructor) {
+  Trundle::BitSet<384> bits;
+  EXPECT_EQ(6u, bits.WordCount);
+  EXPECT_TRUE(bits.none())
+    << "BitSet should be empty when initalized";
+}
+
+TEST(BitSet, SetAndReset) {
+  Trundle::BitSet<384> bits;
+  bits.set(0);
+  bits.set(64);
+  bits.set(383);
+  EXPECT_TRUE(bits.test(0));
+  EXPECT_TRUE(bits.test(64));
+  EXPECT_TRUE(bits.test(383));
+  EXPECT_FALSE(bits.test(1));
+  EXPECT_EQ(uint64_t(1), bits.getWords()[1]);
+
+  bits.reset(64);
+  EXPECT_FALSE(bits.test(64));
+  bits.reset();
+  EXPECT_TRUE(bits.none());
+}
+
+TEST(BitSet, Operators) {
+  Trundle::BitSet<128> a;
+  Trundle::BitSet<128> b;
+  a.set(1);
+  a.set(100);
+  b.set(100);
+  b.set(127);
+
+  EXPECT_TRUE((a & b).test(100));
+  EXPECT_FALSE((a & b).test(1));
+  EXPECT_TRUE((a | b).test(127));
+  EXPECT_TRUE((a ^ b).test(1));
+  EXPECT_FALSE((a ^ b).test(100));
+  EXPECT_FALSE((~a).test(1));
+  EXPECT_TRUE((~a).test(2));
+  EXPECT_EQ(a, a);
+  EXPECT_NE(a, b);
+}
+
+TEST(BitSet, ForEachSet) {
+  Trundle::BitSet<384> bits;
+  std::vector<size_t> expected = {0, 5, 63, 64, 200, 383};
+  for (auto bit : expected) {
+    bits.set(bit);
+  }
+
+  std::vector<size_t> visited;
+  bits.forEachSet([&](size_t bit) { visited.push_back(bit); });
+  EXPECT_EQ(expected, visited)
+    << "Only the set bits should be visited, in ascending order";
+
+  size_t calls = 0;
+  Trundle::BitSet<384>().forEachSet([&](size_t) { ++calls; });
+  EXPECT_EQ(0u, calls)
+    << "An empty set should not visit any bits";
+}
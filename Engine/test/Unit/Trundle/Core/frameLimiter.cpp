@@ -0,0 +1,66 @@
+//===-- frameLimiter.cpp --------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/frameLimiter.h>
+
+TEST(FrameLimiter, NoLimit) {
+  Trundle::FrameLimiter limiter;
+  EXPECT_EQ(0u, limiter.getRate());
+
+  Trundle::Timestamp start = Trundle::getTimestamp();
+  for (int i = 0; i < 1000; ++i) {
+    limiter.wait();
+  }
+  EXPECT_LT(Trundle::getTimestamp() - start, 100000000u)
+    << "Waiting without a limit should return straight away";
+}
+
+TEST(FrameLimiter, Paces) {
+  constexpr Trundle::Timestamp Period = 5000000;
+  Trundle::FrameLimiter limiter(200);
+  EXPECT_EQ(200u, limiter.getRate());
+
+  // The first wait starts the schedule.
+  limiter.wait();
+  Trundle::Timestamp start = Trundle::getTimestamp();
+  Trundle::Timestamp last = start;
+  for (int i = 0; i < 20; ++i) {
+    limiter.wait();
+    Trundle::Timestamp now = Trundle::getTimestamp();
+    EXPECT_GE(now - start, (i + 1) * Period - Period / 10)
+      << "Frame " << i << " was released early";
+    last = now;
+  }
+  EXPECT_LT(last - start, 40 * Period)
+    << "The limiter should not wait much longer than the frame period";
+}
+
+TEST(FrameLimiter, LateFrames) {
+  constexpr Trundle::Timestamp Period = 5000000;
+  Trundle::FrameLimiter limiter(200);
+  limiter.wait();
+  std::this_thread::sleep_for(std::chrono::nanoseconds(3 * Period));
+
+  // A late frame starts a new schedule rather than running the missed frames
+  // back to back.
+  Trundle::Timestamp start = Trundle::getTimestamp();
+  limiter.wait();
+  limiter.wait();
+  EXPECT_GE(Trundle::getTimestamp() - start, Period - Period / 10)
+    << "Frames after a late frame should be paced again";
+}
@@ -0,0 +1,110 @@
+//===-- gamepad.cpp -------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/gamepad.h>
+
+class Gamepads : public testing::Test {
+protected:
+  void SetUp() override {
+    source = std::make_shared<Trundle::ManualGamepadSource>();
+    Trundle::Gamepads::setSource(source);
+  }
+
+  void TearDown() override {
+    Trundle::Gamepads::setSource(nullptr);
+    Trundle::Gamepads::setDeadZone(0.15f);
+    Trundle::Gamepads::poll();
+  }
+
+  std::shared_ptr<Trundle::ManualGamepadSource> source;
+};
+
+TEST_F(Gamepads, Connected) {
+  Trundle::Gamepads::poll();
+  EXPECT_FALSE(Trundle::Gamepads::isConnected(0));
+
+  source->setConnected(3, true);
+  Trundle::Gamepads::poll();
+  EXPECT_TRUE(Trundle::Gamepads::isConnected(3));
+  EXPECT_FALSE(Trundle::Gamepads::isConnected(0));
+
+  Trundle::Gamepads::setSource(nullptr);
+  Trundle::Gamepads::poll();
+  EXPECT_FALSE(Trundle::Gamepads::isConnected(3))
+    << "Gamepads should disconnect without a source";
+}
+
+TEST_F(Gamepads, ButtonEdges) {
+  source->setConnected(0, true);
+  source->setButton(0, Trundle::GamepadButton::A, true);
+  Trundle::Gamepads::poll();
+  EXPECT_TRUE(Trundle::Gamepads::isButtonDown(0, Trundle::GamepadButton::A));
+  EXPECT_TRUE(
+      Trundle::Gamepads::wasPressedThisFrame(0, Trundle::GamepadButton::A));
+  EXPECT_FALSE(Trundle::Gamepads::isButtonDown(0, Trundle::GamepadButton::B));
+
+  Trundle::Gamepads::poll();
+  EXPECT_TRUE(Trundle::Gamepads::isButtonDown(0, Trundle::GamepadButton::A));
+  EXPECT_FALSE(
+      Trundle::Gamepads::wasPressedThisFrame(0, Trundle::GamepadButton::A))
+    << "A held button should only be pressed once";
+
+  source->setButton(0, Trundle::GamepadButton::A, false);
+  Trundle::Gamepads::poll();
+  EXPECT_FALSE(Trundle::Gamepads::isButtonDown(0, Trundle::GamepadButton::A));
+  EXPECT_TRUE(
+      Trundle::Gamepads::wasReleasedThisFrame(0, Trundle::GamepadButton::A));
+
+  source->setButton(0, Trundle::GamepadButton::Start, true);
+  Trundle::Gamepads::poll();
+  source->setConnected(0, false);
+  Trundle::Gamepads::poll();
+  EXPECT_TRUE(Trundle::Gamepads::wasReleasedThisFrame(
+      0, Trundle::GamepadButton::Start))
+    << "Disconnecting should release the buttons";
+}
+
+TEST_F(Gamepads, DeadZone) {
+  Trundle::Gamepads::setDeadZone(0.2f);
+  source->setConnected(1, true);
+  source->setAxis(1, Trundle::GamepadAxis::LeftX, 0.1f);
+  source->setAxis(1, Trundle::GamepadAxis::LeftY, -0.6f);
+  source->setAxis(1, Trundle::GamepadAxis::RightX, 1.0f);
+  source->setAxis(1, Trundle::GamepadAxis::LeftTrigger, 0.1f);
+  Trundle::Gamepads::poll();
+
+  EXPECT_FLOAT_EQ(0.0f,
+                  Trundle::Gamepads::getAxis(1, Trundle::GamepadAxis::LeftX))
+    << "Positions in the dead zone should read as 0";
+  EXPECT_FLOAT_EQ(-0.5f,
+                  Trundle::Gamepads::getAxis(1, Trundle::GamepadAxis::LeftY))
+    << "Positions past the dead zone should be rescaled";
+  EXPECT_FLOAT_EQ(1.0f,
+                  Trundle::Gamepads::getAxis(1, Trundle::GamepadAxis::RightX));
+  EXPECT_FLOAT_EQ(
+      0.1f, Trundle::Gamepads::getAxis(1, Trundle::GamepadAxis::LeftTrigger))
+    << "Triggers should not have a dead zone";
+  EXPECT_FLOAT_EQ(
+      -1.0f, Trundle::Gamepads::getAxis(0, Trundle::GamepadAxis::RightTrigger))
+    << "Disconnected gamepads should be at rest";
+
+  Trundle::Gamepads::setDeadZone(0.0f);
+  EXPECT_FLOAT_EQ(0.1f,
+                  Trundle::Gamepads::getAxis(1, Trundle::GamepadAxis::LeftX))
+    << "Changing the dead zone should apply immediately";
+}
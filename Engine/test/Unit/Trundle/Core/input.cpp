@@ -43,6 +43,15 @@ TEST(Input, SetKeyUp) {
   Trundle::Input::setKeyUp(Trundle::KeyCode::C);
 }
 
+TEST(Input, IsKeyPressed) {
+  Trundle::Input::setKeyDown(Trundle::KeyCode::Q);
+  EXPECT_TRUE(Trundle::Input::isKeyPressed(Trundle::KeyCode::Q))
+    << "isKeyPressed should follow the engine's key state";
+  Trundle::Input::setKeyUp(Trundle::KeyCode::Q);
+  EXPECT_FALSE(Trundle::Input::isKeyPressed(Trundle::KeyCode::Q))
+    << "isKeyPressed should follow the engine's key state";
+}
+
 TEST(Input, SetMouseButtonDown) {
   Trundle::Input::setMouseButtonDown(0);
   EXPECT_TRUE(Trundle::Input::isMouseButtonDown(0))
@@ -183,4 +192,153 @@ TEST(Input, MultipleReleases) {
   Trundle::Input::setMouseButtonUp(0);
   Trundle::Input::setMouseButtonUp(1);
   Trundle::Input::setMouseButtonUp(2);
-}
\ No newline at end of file
+}
+TEST(Input, PressedThisFrame) {
+  Trundle::Input::beginFrame();
+  Trundle::Input::setKeyDown(Trundle::KeyCode::A);
+  Trundle::Input::beginFrame();
+  EXPECT_TRUE(Trundle::Input::wasPressedThisFrame(Trundle::KeyCode::A))
+    << "Key press was not detected";
+  EXPECT_FALSE(Trundle::Input::wasReleasedThisFrame(Trundle::KeyCode::A));
+
+  // A repeat of a held key is not a new press.
+  Trundle::Input::setKeyDown(Trundle::KeyCode::A);
+  Trundle::Input::beginFrame();
+  EXPECT_FALSE(Trundle::Input::wasPressedThisFrame(Trundle::KeyCode::A))
+    << "Held key should only be pressed for one frame";
+
+  // Cleanup
+  Trundle::Input::setKeyUp(Trundle::KeyCode::A);
+  Trundle::Input::beginFrame();
+}
+
+TEST(Input, ReleasedThisFrame) {
+  Trundle::Input::setKeyDown(Trundle::KeyCode::B);
+  Trundle::Input::beginFrame();
+  Trundle::Input::setKeyUp(Trundle::KeyCode::B);
+  Trundle::Input::beginFrame();
+  EXPECT_TRUE(Trundle::Input::wasReleasedThisFrame(Trundle::KeyCode::B))
+    << "Key release was not detected";
+  EXPECT_FALSE(Trundle::Input::wasPressedThisFrame(Trundle::KeyCode::B));
+
+  Trundle::Input::beginFrame();
+  EXPECT_FALSE(Trundle::Input::wasReleasedThisFrame(Trundle::KeyCode::B))
+    << "Key should only be released for one frame";
+}
+
+TEST(Input, TappedThisFrame) {
+  Trundle::Input::beginFrame();
+  Trundle::Input::setKeyDown(Trundle::KeyCode::C);
+  Trundle::Input::setKeyUp(Trundle::KeyCode::C);
+  Trundle::Input::beginFrame();
+  EXPECT_TRUE(Trundle::Input::wasPressedThisFrame(Trundle::KeyCode::C))
+    << "Tap within a single frame was missed";
+  EXPECT_TRUE(Trundle::Input::wasReleasedThisFrame(Trundle::KeyCode::C))
+    << "Tap within a single frame was missed";
+  EXPECT_TRUE(Trundle::Input::isKeyUp(Trundle::KeyCode::C));
+
+  // Cleanup
+  Trundle::Input::beginFrame();
+}
+
+TEST(Input, HandleKeysDownOrder) {
+  Trundle::Input::setKeyDown(Trundle::KeyCode::Z);
+  Trundle::Input::setKeyDown(Trundle::KeyCode::Backspace);
+  Trundle::Input::setKeyDown(Trundle::KeyCode::Joystick8Button19);
+  std::vector<Trundle::KeyCode> keysDown;
+  Trundle::Input::handleKeysDown(
+      [&](Trundle::KeyCode key) { keysDown.push_back(key); });
+
+  std::vector<Trundle::KeyCode> expected = {
+    Trundle::KeyCode::Backspace, Trundle::KeyCode::Z,
+    Trundle::KeyCode::Joystick8Button19};
+  EXPECT_EQ(expected, keysDown)
+    << "Every pressed key should be visited once, in ascending order";
+
+  // Cleanup
+  Trundle::Input::setKeyUp(Trundle::KeyCode::Z);
+  Trundle::Input::setKeyUp(Trundle::KeyCode::Backspace);
+  Trundle::Input::setKeyUp(Trundle::KeyCode::Joystick8Button19);
+}
+
+TEST(Input, MouseDeltaPerFrame) {
+  Trundle::Input::addMouseDelta(1.5, -2.0);
+  Trundle::Input::addMouseDelta(2.5, 1.0);
+  Trundle::Input::addScroll(0.0, 1.0);
+  Trundle::Input::addScroll(0.0, 2.0);
+  Trundle::Input::beginFrame();
+
+  auto [dx, dy] = Trundle::Input::getMouseDelta();
+  EXPECT_DOUBLE_EQ(4.0, dx) << "Mouse moves were not accumulated";
+  EXPECT_DOUBLE_EQ(-1.0, dy) << "Mouse moves were not accumulated";
+  auto [sx, sy] = Trundle::Input::getScrollDelta();
+  EXPECT_DOUBLE_EQ(0.0, sx) << "Scrolls were not accumulated";
+  EXPECT_DOUBLE_EQ(3.0, sy) << "Scrolls were not accumulated";
+
+  Trundle::Input::beginFrame();
+  auto [nextDx, nextDy] = Trundle::Input::getMouseDelta();
+  EXPECT_DOUBLE_EQ(0.0, nextDx) << "Mouse delta was carried into next frame";
+  EXPECT_DOUBLE_EQ(0.0, nextDy) << "Mouse delta was carried into next frame";
+  auto [nextSx, nextSy] = Trundle::Input::getScrollDelta();
+  EXPECT_DOUBLE_EQ(0.0, nextSx) << "Scroll was carried into next frame";
+  EXPECT_DOUBLE_EQ(0.0, nextSy) << "Scroll was carried into next frame";
+}
+
+TEST(Input, Snapshot) {
+  Trundle::Input::setKeyDown(Trundle::KeyCode::D);
+  Trundle::Input::setMouseButtonDown(1);
+  Trundle::Input::setMousePosition(3.0, 4.0);
+  Trundle::Input::addMouseDelta(2.0, -1.0);
+  Trundle::Input::addScroll(0.0, -3.0);
+  uint64_t before = Trundle::Input::getSnapshot().frame;
+  EXPECT_FALSE(Trundle::Input::getSnapshot().isKeyDown(Trundle::KeyCode::D))
+    << "Snapshot should only change when a frame starts";
+
+  Trundle::Input::beginFrame();
+  Trundle::InputSnapshot snapshot;
+  std::thread([&]() { snapshot = Trundle::Input::getSnapshot(); }).join();
+  EXPECT_EQ(before + 1, snapshot.frame);
+  EXPECT_TRUE(snapshot.isKeyDown(Trundle::KeyCode::D));
+  EXPECT_TRUE(snapshot.wasPressedThisFrame(Trundle::KeyCode::D));
+  EXPECT_TRUE(snapshot.isMouseButtonDown(1));
+  EXPECT_FALSE(snapshot.isMouseButtonDown(0));
+  auto [x, y] = snapshot.getMousePosition();
+  EXPECT_DOUBLE_EQ(3.0, x);
+  EXPECT_DOUBLE_EQ(4.0, y);
+  auto [dx, dy] = snapshot.getMouseDelta();
+  EXPECT_DOUBLE_EQ(2.0, dx);
+  EXPECT_DOUBLE_EQ(-1.0, dy);
+  auto [sx, sy] = snapshot.getScrollDelta();
+  EXPECT_DOUBLE_EQ(0.0, sx);
+  EXPECT_DOUBLE_EQ(-3.0, sy);
+
+  // Cleanup
+  Trundle::Input::setKeyUp(Trundle::KeyCode::D);
+  Trundle::Input::setMouseButtonUp(1);
+  Trundle::Input::setMousePosition(0, 0);
+  Trundle::Input::beginFrame();
+}
+
+TEST(Input, Contexts) {
+  Trundle::InputContext context;
+  context.setKeyDown(Trundle::KeyCode::E);
+  EXPECT_TRUE(context.isKeyDown(Trundle::KeyCode::E));
+  EXPECT_FALSE(Trundle::Input::isKeyDown(Trundle::KeyCode::E))
+    << "Contexts should not share their input";
+
+  Trundle::Input::setContext(&context);
+  EXPECT_EQ(&context, &Trundle::Input::getContext());
+  EXPECT_TRUE(Trundle::Input::isKeyDown(Trundle::KeyCode::E))
+    << "Input should forward to the current context";
+
+  bool otherThread = true;
+  std::thread([&]() {
+    otherThread = Trundle::Input::isKeyDown(Trundle::KeyCode::E);
+  }).join();
+  EXPECT_FALSE(otherThread)
+    << "The current context should only change for the calling thread";
+
+  Trundle::Input::setContext(nullptr);
+  EXPECT_FALSE(Trundle::Input::isKeyDown(Trundle::KeyCode::E))
+    << "Input should return to the default context";
+}
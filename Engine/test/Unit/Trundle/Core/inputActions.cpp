@@ -0,0 +1,169 @@
+//===-- inputActions.cpp --------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/inputActions.h>
+
+namespace {
+
+Trundle::InputSnapshot
+makeSnapshot(std::initializer_list<Trundle::KeyCode> keys,
+             uint32_t mouseButtons = 0) {
+  Trundle::InputSnapshot snapshot;
+  for (Trundle::KeyCode key : keys) {
+    snapshot.keysDown.set(static_cast<size_t>(key));
+  }
+  snapshot.mouseButtonsDown = mouseButtons;
+  return snapshot;
+}
+
+} // namespace
+
+TEST(InputActions, AddAction) {
+  Trundle::InputActions actions;
+  Trundle::ActionId jump = actions.addAction("Jump");
+  Trundle::ActionId fire = actions.addAction("Fire");
+  EXPECT_EQ(2u, actions.size());
+  EXPECT_NE(jump, fire);
+  EXPECT_EQ(jump, actions.findAction("Jump"));
+  EXPECT_EQ(fire, actions.findAction("Fire"));
+  EXPECT_EQ(Trundle::InputActions::InvalidAction, actions.findAction("Duck"));
+  EXPECT_EQ("Fire", actions.getName(fire));
+  EXPECT_FALSE(actions.isDown(jump))
+    << "Actions should not be held before the first update";
+}
+
+TEST(InputActions, Bindings) {
+  Trundle::InputActions actions;
+  Trundle::ActionId jump = actions.addAction("Jump");
+  actions.bind(jump, {Trundle::KeyCode::Space});
+  actions.bind(jump, {Trundle::KeyCode::W});
+
+  actions.update(makeSnapshot({Trundle::KeyCode::W}));
+  EXPECT_TRUE(actions.isDown(jump))
+    << "Any binding should hold the action";
+
+  actions.update(makeSnapshot({Trundle::KeyCode::A}));
+  EXPECT_FALSE(actions.isDown(jump))
+    << "Unbound keys should not hold the action";
+
+  actions.unbind(jump);
+  actions.update(makeSnapshot({Trundle::KeyCode::Space}));
+  EXPECT_FALSE(actions.isDown(jump))
+    << "Action was held after being unbound";
+}
+
+TEST(InputActions, Chords) {
+  Trundle::InputActions actions;
+  Trundle::ActionId save = actions.addAction("Save");
+  Trundle::ActionId drag = actions.addAction("Drag");
+  actions.bind(save, {Trundle::KeyCode::LeftControl, Trundle::KeyCode::S});
+  actions.bind(drag, {Trundle::KeyCode::LeftShift}, {0});
+
+  actions.update(makeSnapshot({Trundle::KeyCode::S}));
+  EXPECT_FALSE(actions.isDown(save))
+    << "Chord was held with only some of its keys";
+
+  actions.update(
+      makeSnapshot({Trundle::KeyCode::LeftControl, Trundle::KeyCode::S}));
+  EXPECT_TRUE(actions.isDown(save)) << "Chord was not held";
+  EXPECT_FALSE(actions.isDown(drag));
+
+  actions.update(makeSnapshot({Trundle::KeyCode::LeftShift}, 0b10));
+  EXPECT_FALSE(actions.isDown(drag))
+    << "Chord was held with the wrong mouse button";
+
+  actions.update(makeSnapshot({Trundle::KeyCode::LeftShift}, 0b01));
+  EXPECT_TRUE(actions.isDown(drag)) << "Chord with a mouse button not held";
+}
+
+TEST(InputActions, Edges) {
+  Trundle::InputActions actions;
+  Trundle::ActionId fire = actions.addAction("Fire");
+  actions.bind(fire, {Trundle::KeyCode::F});
+  actions.bind(fire, {}, {0});
+
+  actions.update(makeSnapshot({Trundle::KeyCode::F}));
+  EXPECT_TRUE(actions.wasPressed(fire));
+  EXPECT_FALSE(actions.wasReleased(fire));
+
+  // Switching between bindings keeps the action held.
+  actions.update(makeSnapshot({}, 0b01));
+  EXPECT_TRUE(actions.isDown(fire));
+  EXPECT_FALSE(actions.wasPressed(fire))
+    << "A held action should only be pressed once";
+
+  actions.update(makeSnapshot({}));
+  EXPECT_FALSE(actions.isDown(fire));
+  EXPECT_TRUE(actions.wasReleased(fire));
+
+  actions.update(makeSnapshot({}));
+  EXPECT_FALSE(actions.wasReleased(fire))
+    << "A released action should only be released once";
+
+  const auto& states = actions.getStates();
+  ASSERT_EQ(1u, states.size());
+  EXPECT_FALSE(states[fire].down);
+}
+
+TEST(InputActions, Tap) {
+  Trundle::InputActions actions;
+  Trundle::ActionId jump = actions.addAction("Jump");
+  Trundle::ActionId dash = actions.addAction("Dash");
+  actions.bind(jump, {Trundle::KeyCode::Space});
+  actions.bind(dash, {Trundle::KeyCode::LeftShift, Trundle::KeyCode::D});
+
+  // Space went down and up again between two updates.
+  Trundle::InputSnapshot tap;
+  tap.keysPressed.set(static_cast<size_t>(Trundle::KeyCode::Space));
+  tap.keysReleased.set(static_cast<size_t>(Trundle::KeyCode::Space));
+  actions.update(tap);
+  EXPECT_FALSE(actions.isDown(jump));
+  EXPECT_TRUE(actions.wasPressed(jump)) << "A tap within a frame was lost";
+  EXPECT_TRUE(actions.wasReleased(jump));
+
+  actions.update(makeSnapshot({}));
+  EXPECT_FALSE(actions.wasPressed(jump));
+  EXPECT_FALSE(actions.wasReleased(jump));
+
+  // Tapping one key of a chord while the other is held also taps it.
+  Trundle::InputSnapshot chordTap = makeSnapshot({Trundle::KeyCode::LeftShift});
+  chordTap.keysPressed.set(static_cast<size_t>(Trundle::KeyCode::D));
+  chordTap.keysReleased.set(static_cast<size_t>(Trundle::KeyCode::D));
+  actions.update(chordTap);
+  EXPECT_TRUE(actions.wasPressed(dash));
+  EXPECT_TRUE(actions.wasReleased(dash));
+
+  // Tapping each key of a chord on its own is not a tap of the chord.
+  Trundle::InputSnapshot sequential;
+  for (auto key : {Trundle::KeyCode::LeftShift, Trundle::KeyCode::D}) {
+    sequential.keysPressed.set(static_cast<size_t>(key));
+    sequential.keysReleased.set(static_cast<size_t>(key));
+  }
+  actions.update(sequential);
+  EXPECT_FALSE(actions.wasPressed(dash))
+    << "Keys tapped one after another should not tap their chord";
+  EXPECT_FALSE(actions.wasReleased(dash));
+
+  // A key released without the rest of its chord is not a tap.
+  Trundle::InputSnapshot partial;
+  partial.keysPressed.set(static_cast<size_t>(Trundle::KeyCode::D));
+  partial.keysReleased.set(static_cast<size_t>(Trundle::KeyCode::D));
+  actions.update(partial);
+  EXPECT_FALSE(actions.wasPressed(dash));
+  EXPECT_FALSE(actions.wasReleased(dash));
+}
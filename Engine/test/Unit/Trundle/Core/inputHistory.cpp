@@ -0,0 +1,146 @@
+//===-- inputHistory.cpp --------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/inputHistory.h>
+
+namespace {
+
+Trundle::InputRecord makeRecord(uint64_t frame, bool aDown) {
+  Trundle::InputRecord record;
+  record.frame = frame;
+  if (aDown) {
+    record.keysDown.set(static_cast<size_t>(Trundle::KeyCode::A));
+  }
+  record.mouseX = static_cast<double>(frame);
+  record.mouseY = -static_cast<double>(frame);
+  return record;
+}
+
+} // namespace
+
+TEST(InputHistory, DefaultConstructor) {
+  Trundle::InputHistory history;
+  EXPECT_EQ(0u, history.size())
+    << "History should be empty when initalized";
+  EXPECT_EQ(64u, history.capacity());
+  EXPECT_EQ(nullptr, history.get(0));
+}
+
+TEST(InputHistory, Lookup) {
+  Trundle::InputHistory history(8);
+  for (uint64_t frame = 1; frame <= 20; ++frame) {
+    history.push(makeRecord(frame, false));
+  }
+  EXPECT_EQ(8u, history.size());
+  EXPECT_EQ(13u, history.getOldestFrame());
+  EXPECT_EQ(20u, history.getNewestFrame());
+
+  ASSERT_NE(nullptr, history.get(13));
+  EXPECT_EQ(13.0, history.get(13)->mouseX);
+  EXPECT_EQ(nullptr, history.get(12))
+    << "Frames older than the capacity should be dropped";
+  EXPECT_EQ(nullptr, history.get(21))
+    << "Future frames should not be found";
+}
+
+TEST(InputHistory, SkippedFrames) {
+  Trundle::InputHistory history(8);
+  history.push(makeRecord(1, false));
+  history.push(makeRecord(4, false));
+  EXPECT_EQ(4u, history.size());
+  EXPECT_NE(nullptr, history.get(1));
+  EXPECT_EQ(nullptr, history.get(2))
+    << "Skipped frames should not have a record";
+  EXPECT_NE(nullptr, history.get(4));
+
+  history.push(makeRecord(100, false));
+  EXPECT_EQ(8u, history.size());
+  EXPECT_EQ(nullptr, history.get(4))
+    << "A gap larger than the capacity should drop every older frame";
+}
+
+TEST(InputHistory, Edges) {
+  Trundle::InputHistory history(8);
+  history.push(makeRecord(1, false));
+  history.push(makeRecord(2, true));
+  history.push(makeRecord(3, true));
+  history.push(makeRecord(4, false));
+
+  EXPECT_TRUE(history.wasPressed(2, Trundle::KeyCode::A));
+  EXPECT_FALSE(history.wasPressed(3, Trundle::KeyCode::A));
+  EXPECT_TRUE(history.wasReleased(4, Trundle::KeyCode::A));
+  EXPECT_FALSE(history.wasPressed(1, Trundle::KeyCode::A))
+    << "The first frame has nothing to compare against";
+}
+
+TEST(InputHistory, Serialize) {
+  Trundle::InputHistory history(8);
+  history.push(makeRecord(5, true));
+  history.push(makeRecord(6, false));
+  history.push(makeRecord(8, true));
+
+  std::vector<uint8_t> bytes;
+  history.serialize(bytes);
+  EXPECT_EQ(8 + 3 * Trundle::InputRecord::SerializedSize, bytes.size());
+  // The frame of the first record, in little endian order.
+  EXPECT_EQ(5u, bytes[8]);
+  EXPECT_EQ(0u, bytes[9]);
+
+  Trundle::InputHistory copy(8);
+  ASSERT_TRUE(copy.deserialize(bytes.data(), bytes.size()));
+  EXPECT_EQ(history.size(), copy.size());
+  EXPECT_EQ(nullptr, copy.get(7));
+  for (uint64_t frame : {5, 6, 8}) {
+    ASSERT_NE(nullptr, copy.get(frame));
+    EXPECT_EQ(history.get(frame)->keysDown, copy.get(frame)->keysDown);
+    EXPECT_EQ(history.get(frame)->mouseY, copy.get(frame)->mouseY);
+  }
+
+  std::vector<uint8_t> again;
+  copy.serialize(again);
+  EXPECT_EQ(bytes, again)
+    << "Serialization should be deterministic";
+
+  EXPECT_FALSE(copy.deserialize(bytes.data(), bytes.size() - 1))
+    << "Truncated data should be rejected";
+  EXPECT_EQ(0u, copy.size());
+}
+
+TEST(InputHistory, DeserializeIntoNonEmpty) {
+  Trundle::InputHistory remote(16);
+  remote.push(makeRecord(5, true));
+  remote.push(makeRecord(10, false));
+  std::vector<uint8_t> bytes;
+  remote.serialize(bytes);
+
+  Trundle::InputHistory local(16);
+  for (uint64_t frame = 1; frame <= 10; ++frame) {
+    local.push(makeRecord(frame, false));
+  }
+  ASSERT_TRUE(local.deserialize(bytes.data(), bytes.size()));
+  EXPECT_EQ(nullptr, local.get(7))
+    << "Records from before deserializing should be gone";
+  ASSERT_NE(nullptr, local.get(5));
+  EXPECT_TRUE(local.get(5)->keysDown.test(
+      static_cast<size_t>(Trundle::KeyCode::A)));
+
+  std::vector<uint8_t> again;
+  local.serialize(again);
+  EXPECT_EQ(bytes, again)
+    << "Only the deserialized records should be serialized";
+}
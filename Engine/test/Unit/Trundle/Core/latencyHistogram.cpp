@@ -0,0 +1,74 @@
+//===-- latencyHistogram.cpp ----------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/latencyHistogram.h>
+
+TEST(LatencyHistogram, DefaultConstructor) {
+  Trundle::LatencyHistogram histogram;
+  EXPECT_EQ(0u, histogram.getCount());
+  EXPECT_EQ(0u, histogram.getMin());
+  EXPECT_EQ(0u, histogram.getMax());
+  EXPECT_EQ(0u, histogram.getMean());
+  EXPECT_EQ(0u, histogram.getPercentile(50));
+}
+
+TEST(LatencyHistogram, Buckets) {
+  EXPECT_EQ(0u, Trundle::LatencyHistogram::getBucket(0));
+  EXPECT_EQ(1u, Trundle::LatencyHistogram::getBucket(1));
+  EXPECT_EQ(2u, Trundle::LatencyHistogram::getBucket(2));
+  EXPECT_EQ(2u, Trundle::LatencyHistogram::getBucket(3));
+  EXPECT_EQ(11u, Trundle::LatencyHistogram::getBucket(1024));
+  EXPECT_EQ(64u, Trundle::LatencyHistogram::getBucket(~uint64_t(0)));
+}
+
+TEST(LatencyHistogram, Record) {
+  Trundle::LatencyHistogram histogram;
+  histogram.record(1000);
+  histogram.record(3000);
+  histogram.record(2000);
+  EXPECT_EQ(3u, histogram.getCount());
+  EXPECT_EQ(1000u, histogram.getMin());
+  EXPECT_EQ(3000u, histogram.getMax());
+  EXPECT_EQ(2000u, histogram.getMean());
+
+  auto bucket = Trundle::LatencyHistogram::getBucket(1000);
+  EXPECT_EQ(1u, histogram.getBuckets()[bucket]);
+}
+
+TEST(LatencyHistogram, Percentile) {
+  Trundle::LatencyHistogram histogram;
+  for (int i = 0; i < 99; ++i) {
+    histogram.record(100);
+  }
+  histogram.record(1000000);
+
+  // 100ns falls in the bucket [64, 128).
+  EXPECT_EQ(127u, histogram.getPercentile(50));
+  EXPECT_EQ(127u, histogram.getPercentile(99));
+  EXPECT_EQ(1000000u, histogram.getPercentile(100))
+    << "The estimate should be clamped to the largest latency";
+}
+
+TEST(LatencyHistogram, Clear) {
+  Trundle::LatencyHistogram histogram;
+  histogram.record(10);
+  histogram.clear();
+  EXPECT_EQ(0u, histogram.getCount());
+  auto bucket = Trundle::LatencyHistogram::getBucket(10);
+  EXPECT_EQ(0u, histogram.getBuckets()[bucket]);
+}
@@ -162,4 +162,295 @@ TEST(LayerStack, LayerOrdering) {
     << "Incorrect fifth element from the end";
   EXPECT_EQ(overlay3, *(stack.end()-6))
     << "Incorrect sixth element from the end";
-}
\ No newline at end of file
+}
+
+class KeyLayer : public Trundle::Layer {
+public:
+  KeyLayer() : Layer("KeyLayer") {
+    subscribe(Trundle::EventCategory::KeyEvent);
+  }
+};
+
+TEST(LayerStack, Subscribers) {
+  Trundle::LayerStack stack;
+  auto layer = std::make_shared<Trundle::Layer>();
+  auto keyLayer = std::make_shared<KeyLayer>();
+  stack.pushLayer(layer);
+  stack.pushOverlay(keyLayer);
+
+  const auto& keySubscribers =
+      stack.getSubscribers(Trundle::EventType::KeyPress);
+  ASSERT_EQ(2u, keySubscribers.size());
+  EXPECT_EQ(keyLayer.get(), keySubscribers[0])
+    << "Overlay should be offered events before layers";
+  EXPECT_EQ(layer.get(), keySubscribers[1]);
+
+  const auto& mouseSubscribers =
+      stack.getSubscribers(Trundle::EventType::MouseMove);
+  ASSERT_EQ(1u, mouseSubscribers.size())
+    << "Layer did not subscribe to mouse events";
+  EXPECT_EQ(layer.get(), mouseSubscribers[0]);
+
+  stack.popOverlay(keyLayer);
+  EXPECT_EQ(1u, stack.getSubscribers(Trundle::EventType::KeyPress).size())
+    << "Popped layer should no longer be subscribed";
+}
+TEST(LayerStack, GetLayers) {
+  Trundle::LayerStack stack;
+  auto layer1 = std::make_shared<Trundle::Layer>();
+  auto layer2 = std::make_shared<Trundle::Layer>();
+  auto overlay = std::make_shared<Trundle::Layer>();
+  stack.pushLayer(layer1);
+  stack.pushOverlay(overlay);
+  stack.pushLayer(layer2);
+
+  std::vector<Trundle::Layer*> expected;
+  for (auto layer : stack) {
+    expected.push_back(layer.get());
+  }
+  EXPECT_EQ(expected, stack.getLayers())
+    << "The view should match the order of iterating the stack";
+  EXPECT_EQ(2, layer1.use_count())
+    << "The view should not own the layers";
+
+  stack.popLayer(layer1);
+  ASSERT_EQ(2u, stack.getLayers().size());
+  EXPECT_EQ(overlay.get(), stack.getLayers()[0]);
+  EXPECT_EQ(layer2.get(), stack.getLayers()[1]);
+}
+
+TEST(LayerStack, PopKeepsSegments) {
+  Trundle::LayerStack stack;
+  auto layer1 = std::make_shared<Trundle::Layer>();
+  auto layer2 = std::make_shared<Trundle::Layer>();
+  auto overlay1 = std::make_shared<Trundle::Layer>();
+  auto overlay2 = std::make_shared<Trundle::Layer>();
+  stack.pushLayer(layer1);
+  stack.pushOverlay(overlay1);
+  // Popping an overlay through popLayer must not move the boundary between
+  // the layers and the overlays.
+  stack.popLayer(overlay1);
+  stack.pushOverlay(overlay2);
+  stack.pushLayer(layer2);
+
+  std::vector<Trundle::Layer*> expected = {overlay2.get(), layer2.get(),
+                                           layer1.get()};
+  EXPECT_EQ(expected, stack.getLayers())
+    << "Layers were pushed above an overlay";
+}
+
+TEST(LayerStack, PopFromMiddle) {
+  Trundle::LayerStack stack;
+  std::vector<std::shared_ptr<Trundle::Layer>> layers;
+  for (int i = 0; i < 6; ++i) {
+    layers.push_back(std::make_shared<Trundle::Layer>());
+  }
+  stack.pushLayer(layers[0]);
+  stack.pushLayer(layers[1]);
+  stack.pushOverlay(layers[2]);
+  stack.pushLayer(layers[3]);
+  stack.pushOverlay(layers[4]);
+  stack.pushLayer(layers[5]);
+
+  // Every pop moves the layers above it, which must still be found after.
+  stack.popLayer(layers[1]);
+  stack.popLayer(layers[2]);
+  stack.popLayer(layers[0]);
+  std::vector<Trundle::Layer*> expected = {layers[4].get(), layers[5].get(),
+                                           layers[3].get()};
+  EXPECT_EQ(expected, stack.getLayers());
+
+  stack.popLayer(layers[4]);
+  stack.popLayer(layers[3]);
+  stack.popLayer(layers[5]);
+  EXPECT_EQ(0u, stack.size());
+}
+
+TEST(LayerStack, Handles) {
+  Trundle::LayerStack stack;
+  auto layer = std::make_shared<Trundle::Layer>();
+  auto handle = stack.pushLayer(layer);
+  EXPECT_EQ(layer.get(), stack.get(handle));
+
+  stack.pop(handle);
+  EXPECT_EQ(0u, stack.size());
+  EXPECT_EQ(nullptr, stack.get(handle))
+    << "Handle should be invalid after its layer is popped";
+
+  auto other = std::make_shared<Trundle::Layer>();
+  auto reused = stack.pushLayer(other);
+  EXPECT_EQ(handle.index, reused.index) << "Slot should be reused";
+  EXPECT_NE(handle, reused);
+  EXPECT_EQ(nullptr, stack.get(handle))
+    << "Old handle should not refer to the layer in its reused slot";
+
+  stack.pop(handle);
+  EXPECT_EQ(1u, stack.size()) << "Popping a stale handle removed a layer";
+}
+
+TEST(LayerStack, DeferredDuringTraversal) {
+  Trundle::LayerStack stack;
+  auto layer1 = std::make_shared<Trundle::Layer>();
+  auto layer2 = std::make_shared<Trundle::Layer>();
+  stack.pushLayer(layer1);
+
+  stack.beginTraversal();
+  const auto& view = stack.getLayers();
+  Trundle::Layer* first = view[0];
+  stack.pushLayer(layer2);
+  stack.popLayer(layer1);
+  EXPECT_EQ(1u, view.size()) << "Stack changed during a traversal";
+  EXPECT_EQ(first, view[0]);
+  stack.applyPending();
+  EXPECT_EQ(1u, view.size()) << "Changes applied during a traversal";
+  stack.endTraversal();
+
+  stack.applyPending();
+  ASSERT_EQ(1u, stack.getLayers().size());
+  EXPECT_EQ(layer2.get(), stack.getLayers()[0])
+    << "Queued changes were not applied in order";
+}
+
+TEST(LayerStack, RepushDuringTraversal) {
+  Trundle::LayerStack stack;
+  auto layer1 = std::make_shared<Trundle::Layer>();
+  auto layer2 = std::make_shared<Trundle::Layer>();
+  stack.pushLayer(layer1);
+  stack.pushLayer(layer2);
+
+  // Move the bottom layer to the top while the stack is traversed.
+  stack.beginTraversal();
+  stack.popLayer(layer1);
+  stack.pushLayer(layer1);
+  stack.endTraversal();
+  stack.applyPending();
+
+  std::vector<Trundle::Layer*> expected = {layer1.get(), layer2.get()};
+  EXPECT_EQ(expected, stack.getLayers()) << "The layer was not moved";
+
+  stack.popLayer(layer1);
+  ASSERT_EQ(1u, stack.size()) << "The pushed layer can not be popped";
+  EXPECT_EQ(layer2.get(), stack.getLayers()[0]);
+}
+
+// A layer that declares the dependencies of its update.
+class DependentLayer : public Trundle::Layer {
+public:
+  DependentLayer(const std::string& name,
+                 std::initializer_list<std::string> readList,
+                 std::initializer_list<std::string> writeList,
+                 std::initializer_list<std::string> afterList = {})
+    : Layer(name) {
+    for (const auto& resource : readList) {
+      reads(resource);
+    }
+    for (const auto& resource : writeList) {
+      writes(resource);
+    }
+    for (const auto& layer : afterList) {
+      runsAfter(layer);
+    }
+  }
+};
+
+TEST(LayerStack, UpdateLevels) {
+  Trundle::LayerStack stack;
+  EXPECT_TRUE(stack.getUpdateLevels().empty());
+
+  auto plain1 = std::make_shared<Trundle::Layer>();
+  auto plain2 = std::make_shared<Trundle::Layer>();
+  stack.pushLayer(plain1);
+  stack.pushLayer(plain2);
+  EXPECT_EQ(2u, stack.getUpdateLevels().size())
+    << "Layers without dependencies should be updated one at a time";
+  stack.popLayer(plain1);
+  stack.popLayer(plain2);
+
+  auto audio = std::make_shared<DependentLayer>(
+      "Audio", std::initializer_list<std::string>{"world"},
+      std::initializer_list<std::string>{"audio"});
+  auto ai = std::make_shared<DependentLayer>(
+      "AI", std::initializer_list<std::string>{"world"},
+      std::initializer_list<std::string>{"ai"});
+  auto physics = std::make_shared<DependentLayer>(
+      "Physics", std::initializer_list<std::string>{},
+      std::initializer_list<std::string>{"world"});
+  stack.pushLayer(physics);
+  stack.pushLayer(ai);
+  stack.pushLayer(audio);
+
+  // The stack is iterated from the top, so audio and ai come before the
+  // physics layer that writes what they read.
+  const auto& levels = stack.getUpdateLevels();
+  ASSERT_EQ(2u, levels.size());
+  EXPECT_EQ((std::vector<Trundle::Layer*>{audio.get(), ai.get()}), levels[0])
+    << "Independent layers should share a level in stack order";
+  EXPECT_EQ(std::vector<Trundle::Layer*>{physics.get()}, levels[1])
+    << "A writer should wait for the readers above it";
+
+  auto ui = std::make_shared<DependentLayer>(
+      "UI", std::initializer_list<std::string>{},
+      std::initializer_list<std::string>{"ui"},
+      std::initializer_list<std::string>{"Physics"});
+  stack.pushOverlay(ui);
+  ASSERT_EQ(3u, stack.getUpdateLevels().size());
+  EXPECT_EQ(std::vector<Trundle::Layer*>{ui.get()},
+            stack.getUpdateLevels()[2])
+    << "runsAfter should hold even against the stack order";
+
+  auto plain3 = std::make_shared<Trundle::Layer>();
+  stack.pushLayer(plain3);
+  ASSERT_EQ(4u, stack.getUpdateLevels().size());
+  EXPECT_EQ(std::vector<Trundle::Layer*>{plain3.get()},
+            stack.getUpdateLevels()[0])
+    << "A layer without dependencies should conflict with every layer";
+  stack.popLayer(plain3);
+
+  auto ordered = std::make_shared<DependentLayer>(
+      "Ordered", std::initializer_list<std::string>{},
+      std::initializer_list<std::string>{},
+      std::initializer_list<std::string>{"AI"});
+  EXPECT_FALSE(ordered->hasDependencies())
+    << "runsAfter should not declare a resource";
+  stack.pushLayer(ordered);
+  for (const auto& level : stack.getUpdateLevels()) {
+    if (std::find(level.begin(), level.end(), ordered.get()) != level.end()) {
+      EXPECT_EQ(1u, level.size())
+        << "A layer that only orders itself should conflict with every layer";
+    }
+  }
+}
+
+TEST(LayerStack, UpdateLevelsCycle) {
+  Trundle::LayerStack stack;
+  auto first = std::make_shared<DependentLayer>(
+      "First", std::initializer_list<std::string>{},
+      std::initializer_list<std::string>{"first"},
+      std::initializer_list<std::string>{"Second"});
+  auto second = std::make_shared<DependentLayer>(
+      "Second", std::initializer_list<std::string>{},
+      std::initializer_list<std::string>{"second"},
+      std::initializer_list<std::string>{"First"});
+  auto third = std::make_shared<Trundle::Layer>();
+  stack.pushLayer(first);
+  stack.pushLayer(second);
+  stack.pushLayer(third);
+
+  const auto& levels = stack.getUpdateLevels();
+  ASSERT_EQ(3u, levels.size())
+    << "A cycle should fall back to one layer per level";
+  for (size_t i = 0; i < levels.size(); ++i) {
+    ASSERT_EQ(1u, levels[i].size());
+    EXPECT_EQ(stack.getLayers()[i], levels[i][0])
+      << "A cycle should fall back to stack order";
+  }
+
+  stack.popLayer(second);
+  ASSERT_EQ(2u, stack.getUpdateLevels().size())
+    << "Popped layers should not be left in the levels";
+  for (const auto& level : stack.getUpdateLevels()) {
+    for (Trundle::Layer* layer : level) {
+      EXPECT_NE(second.get(), layer);
+    }
+  }
+}
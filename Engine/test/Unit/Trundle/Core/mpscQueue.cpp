@@ -0,0 +1,110 @@
+//===-- mpscQueue.cpp -----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/mpscQueue.h>
+
+TEST(MPSCQueue, PushPop) {
+  Trundle::MPSCQueue<int> queue(4);
+  int value = 0;
+  EXPECT_FALSE(queue.pop(value))
+    << "Queue should be empty when initalized";
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_FALSE(queue.empty());
+  EXPECT_TRUE(queue.push(2));
+  ASSERT_TRUE(queue.pop(value));
+  EXPECT_EQ(1, value) << "Values were not popped in order";
+  ASSERT_TRUE(queue.pop(value));
+  EXPECT_EQ(2, value) << "Values were not popped in order";
+  EXPECT_FALSE(queue.pop(value));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(MPSCQueue, Full) {
+  Trundle::MPSCQueue<int> queue(4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.push(i));
+  }
+  EXPECT_FALSE(queue.push(4))
+    << "Push should fail when the queue is full";
+
+  int value = 0;
+  ASSERT_TRUE(queue.pop(value));
+  EXPECT_TRUE(queue.push(4))
+    << "Push should succeed once space is freed";
+}
+
+TEST(MPSCQueue, WrapAround) {
+  Trundle::MPSCQueue<int> queue(2);
+  int value = 0;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(queue.push(i));
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(i, value);
+  }
+}
+
+TEST(MPSCQueue, ManyProducers) {
+  constexpr int producers = 8;
+  constexpr int perProducer = 100000;
+  Trundle::MPSCQueue<uint64_t> queue(1024);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue, p]() {
+      for (uint64_t i = 0; i < perProducer; ++i) {
+        uint64_t value = (static_cast<uint64_t>(p) << 32) | i;
+        while (!queue.push(value)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Each producer's values must arrive in the order they were pushed. Keep
+  // draining after a failure so that the producers can finish and be joined.
+  std::vector<uint64_t> next(producers, 0);
+  int received = 0;
+  int unknown = 0;
+  int reordered = 0;
+  uint64_t value = 0;
+  while (received < producers * perProducer) {
+    if (queue.pop(value)) {
+      ++received;
+      size_t producer = value >> 32;
+      if (producer >= next.size()) {
+        ++unknown;
+        continue;
+      }
+      if (next[producer] != (value & 0xffffffff)) {
+        ++reordered;
+      }
+      next[producer] = (value & 0xffffffff) + 1;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0, unknown) << "Values arrived from an unknown producer";
+  EXPECT_EQ(0, reordered) << "Values from a producer were reordered";
+  EXPECT_FALSE(queue.pop(value))
+    << "Queue should be empty after every value was received";
+}
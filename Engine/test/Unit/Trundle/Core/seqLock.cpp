@@ -0,0 +1,99 @@
+//===-- seqLock.cpp -------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/seqLock.h>
+
+namespace {
+
+struct Sample {
+  uint64_t values[8];
+  double x;
+  double y;
+};
+
+} // namespace
+
+TEST(SeqLock, DefaultConstructor) {
+  Trundle::SeqLock<Sample> lock;
+  Sample sample = lock.load();
+  EXPECT_EQ(0u, sample.values[0]);
+  EXPECT_EQ(0.0, sample.x);
+  EXPECT_EQ(1u, lock.getVersion());
+}
+
+TEST(SeqLock, StoreAndLoad) {
+  Trundle::SeqLock<Sample> lock;
+  Sample sample{};
+  sample.values[7] = 42;
+  sample.x = 1.5;
+  sample.y = -2.5;
+  lock.store(sample);
+
+  Sample loaded = lock.load();
+  EXPECT_EQ(42u, loaded.values[7]);
+  EXPECT_EQ(1.5, loaded.x);
+  EXPECT_EQ(-2.5, loaded.y);
+  EXPECT_EQ(2u, lock.getVersion());
+}
+
+TEST(SeqLock, NoTornReads) {
+  // Every field of a published sample holds the same number, so a reader
+  // that sees a mix of two writes would see different numbers.
+  constexpr uint64_t writes = 200000;
+  Trundle::SeqLock<Sample> lock;
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> readers;
+  std::atomic<uint64_t> torn{0};
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      uint64_t last = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        Sample sample = lock.load();
+        for (auto value : sample.values) {
+          if (value != sample.values[0]) {
+            ++torn;
+          }
+        }
+        if (sample.x != static_cast<double>(sample.values[0]) ||
+            sample.values[0] < last) {
+          ++torn;
+        }
+        last = sample.values[0];
+      }
+    });
+  }
+
+  for (uint64_t i = 1; i <= writes; ++i) {
+    Sample sample;
+    for (auto& value : sample.values) {
+      value = i;
+    }
+    sample.x = static_cast<double>(i);
+    sample.y = static_cast<double>(i);
+    lock.store(sample);
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(0u, torn.load())
+    << "Readers saw a value that was only partly written";
+  EXPECT_EQ(writes, lock.load().values[0]);
+}
@@ -0,0 +1,168 @@
+//===-- timerWheel.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/timerWheel.h>
+
+#include <random>
+
+namespace {
+
+constexpr Trundle::Timestamp Millisecond = 1000000;
+
+std::vector<uint32_t> advance(Trundle::TimerWheel& wheel,
+                              Trundle::Timestamp now) {
+  std::vector<Trundle::TimerWheel::Expired> expired;
+  wheel.advance(now, expired);
+  std::vector<uint32_t> codes;
+  for (const auto& timer : expired) {
+    codes.push_back(timer.code);
+  }
+  return codes;
+}
+
+} // namespace
+
+TEST(TimerWheel, DefaultConstructor) {
+  Trundle::TimerWheel wheel;
+  EXPECT_EQ(0u, wheel.size())
+    << "Wheel should be empty when initalized";
+  EXPECT_FALSE(wheel.isPending(Trundle::TimerHandle{}));
+}
+
+TEST(TimerWheel, OneShot) {
+  Trundle::TimerWheel wheel;
+  auto handle = wheel.schedule(250 * Millisecond, 1);
+  EXPECT_TRUE(wheel.isPending(handle));
+  EXPECT_EQ(1u, wheel.size());
+
+  EXPECT_TRUE(advance(wheel, 249 * Millisecond).empty())
+    << "Timer fired before its deadline";
+  EXPECT_EQ(std::vector<uint32_t>{1}, advance(wheel, 250 * Millisecond));
+  EXPECT_FALSE(wheel.isPending(handle))
+    << "One shot timers should not be pending after firing";
+  EXPECT_EQ(0u, wheel.size());
+  EXPECT_TRUE(advance(wheel, 1000 * Millisecond).empty())
+    << "One shot timers should only fire once";
+}
+
+TEST(TimerWheel, Periodic) {
+  Trundle::TimerWheel wheel;
+  auto handle = wheel.schedule(2000 * Millisecond, 7, 2000 * Millisecond);
+
+  size_t fired = 0;
+  for (Trundle::Timestamp t = 0; t <= 10000; t += 16) {
+    fired += advance(wheel, t * Millisecond).size();
+  }
+  EXPECT_EQ(5u, fired)
+    << "Periodic timer should fire every period";
+  EXPECT_TRUE(wheel.isPending(handle));
+
+  EXPECT_TRUE(wheel.cancel(handle));
+  EXPECT_TRUE(advance(wheel, 20000 * Millisecond).empty())
+    << "Cancelled periodic timer fired";
+}
+
+TEST(TimerWheel, Cancel) {
+  Trundle::TimerWheel wheel;
+  auto first = wheel.schedule(10 * Millisecond, 1);
+  auto second = wheel.schedule(10 * Millisecond, 2);
+  EXPECT_TRUE(wheel.cancel(first));
+  EXPECT_FALSE(wheel.cancel(first))
+    << "A timer should only be cancelled once";
+  EXPECT_EQ(std::vector<uint32_t>{2}, advance(wheel, 10 * Millisecond));
+  EXPECT_FALSE(wheel.cancel(second))
+    << "A fired timer cannot be cancelled";
+}
+
+TEST(TimerWheel, StaleHandle) {
+  Trundle::TimerWheel wheel;
+  auto stale = wheel.schedule(10 * Millisecond, 1);
+  wheel.cancel(stale);
+  auto fresh = wheel.schedule(10 * Millisecond, 2);
+  EXPECT_EQ(stale.index, fresh.index)
+    << "The node of a cancelled timer should be reused";
+  EXPECT_FALSE(wheel.cancel(stale))
+    << "A stale handle should not cancel the timer that reused its node";
+  EXPECT_TRUE(wheel.isPending(fresh));
+}
+
+TEST(TimerWheel, DeadlineInThePast) {
+  Trundle::TimerWheel wheel(100 * Millisecond);
+  wheel.schedule(0, 1);
+  EXPECT_EQ(std::vector<uint32_t>{1}, advance(wheel, 101 * Millisecond))
+    << "Timers that are already due should fire on the next tick";
+}
+
+TEST(TimerWheel, ManyTimers) {
+  // Deadlines spread over several levels of the wheel must all fire on time
+  // and in order.
+  Trundle::TimerWheel wheel;
+  std::mt19937 random(42);
+  std::uniform_int_distribution<uint32_t> delay(1, 5000000);
+  std::vector<uint32_t> deadlines;
+  for (int i = 0; i < 5000; ++i) {
+    uint32_t deadline = delay(random);
+    deadlines.push_back(deadline);
+    wheel.schedule(deadline * Millisecond, deadline);
+  }
+  EXPECT_EQ(5000u, wheel.size());
+
+  std::vector<uint32_t> fired;
+  for (Trundle::Timestamp t = 0; t <= 5000000; t += 997) {
+    for (auto code : advance(wheel, t * Millisecond)) {
+      EXPECT_LE(code, t) << "Timer fired early";
+      EXPECT_GT(code + 997, t) << "Timer fired late";
+      fired.push_back(code);
+    }
+  }
+  for (auto code : advance(wheel, 5000000 * Millisecond)) {
+    fired.push_back(code);
+  }
+
+  std::sort(deadlines.begin(), deadlines.end());
+  EXPECT_EQ(deadlines, fired)
+    << "Every timer should fire exactly once, in deadline order";
+  EXPECT_EQ(0u, wheel.size());
+}
+
+TEST(TimerWheel, NextWake) {
+  Trundle::TimerWheel wheel;
+  EXPECT_EQ(~Trundle::Timestamp(0), wheel.getNextWake())
+    << "An empty wheel should never need to wake";
+
+  wheel.schedule(40 * Millisecond, 1);
+  EXPECT_EQ(40 * Millisecond, wheel.getNextWake())
+    << "Timers in the finest level should wake at their deadline";
+  advance(wheel, 40 * Millisecond);
+
+  wheel.schedule(250 * Millisecond, 2);
+  wheel.schedule(100000 * Millisecond, 3);
+  std::vector<uint32_t> fired;
+  Trundle::Timestamp now = 40 * Millisecond;
+  while (wheel.size() != 0) {
+    Trundle::Timestamp wake = wheel.getNextWake();
+    ASSERT_GT(wake, now) << "The wheel should always wake in the future";
+    now = wake;
+    for (auto code : advance(wheel, now)) {
+      fired.push_back(code);
+      EXPECT_EQ(code == 2 ? 250 * Millisecond : 100000 * Millisecond, now)
+        << "Sleeping until the next wake should never fire a timer late";
+    }
+  }
+  EXPECT_EQ((std::vector<uint32_t>{2, 3}), fired);
+}
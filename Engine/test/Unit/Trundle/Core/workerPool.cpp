@@ -0,0 +1,57 @@
+//===-- workerPool.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Core/workerPool.h>
+
+TEST(WorkerPool, RunsEveryTask) {
+  Trundle::WorkerPool pool(3);
+  EXPECT_EQ(4u, pool.size());
+
+  std::vector<std::atomic<int>> runs(100);
+  pool.run(runs.size(), [&](size_t i) { ++runs[i]; });
+  for (size_t i = 0; i < runs.size(); ++i) {
+    EXPECT_EQ(1, runs[i].load()) << "Task " << i << " was not run once";
+  }
+}
+
+TEST(WorkerPool, NoWorkers) {
+  Trundle::WorkerPool pool(0);
+  EXPECT_EQ(1u, pool.size());
+
+  std::thread::id caller = std::this_thread::get_id();
+  size_t count = 0;
+  pool.run(10, [&](size_t) {
+    EXPECT_EQ(caller, std::this_thread::get_id())
+      << "A pool without workers should run tasks on the caller";
+    ++count;
+  });
+  EXPECT_EQ(10u, count);
+}
+
+TEST(WorkerPool, ManyBatches) {
+  Trundle::WorkerPool pool(4);
+  std::atomic<size_t> total{0};
+  for (size_t batch = 0; batch < 1000; ++batch) {
+    std::atomic<size_t> count{0};
+    pool.run(batch % 8, [&](size_t) { ++count; });
+    EXPECT_EQ(batch % 8, count.load())
+      << "run returned before every task had finished";
+    total += count;
+  }
+  EXPECT_EQ(3500u, total.load());
+}
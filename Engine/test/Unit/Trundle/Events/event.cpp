@@ -0,0 +1,72 @@
+//===-- event.cpp ---------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Events/event.h>
+#include <Trundle/Events/keyEvent.h>
+#include <Trundle/Events/mouseEvent.h>
+
+class Handlers {
+public:
+  bool onKeyPress(Trundle::KeyPressEvent& event) {
+    lastKey = event.getKeyCode();
+    return true;
+  }
+
+  bool onMouseMove(Trundle::MouseMoveEvent&) {
+    ++moves;
+    return false;
+  }
+
+  int lastKey{-1};
+  int moves{0};
+};
+
+static constexpr auto table =
+    Trundle::EventDispatchTable<Handlers>()
+        .bind<Trundle::KeyPressEvent, &Handlers::onKeyPress>()
+        .bind<Trundle::MouseMoveEvent, &Handlers::onMouseMove>();
+
+TEST(EventDispatchTable, Dispatch) {
+  Handlers handlers;
+  Trundle::KeyPressEvent event(65, false);
+  EXPECT_TRUE(table.dispatch(handlers, event))
+    << "Bound handler was not found";
+  EXPECT_EQ(65, handlers.lastKey)
+    << "Handler was not called with the event";
+  EXPECT_TRUE(event.handled)
+    << "Handled flag was not set from the handler";
+}
+
+TEST(EventDispatchTable, HandlerResult) {
+  Handlers handlers;
+  Trundle::MouseMoveEvent event(1, 1);
+  EXPECT_TRUE(table.dispatch(handlers, event));
+  EXPECT_EQ(1, handlers.moves);
+  EXPECT_FALSE(event.handled)
+    << "Handled flag should match the handler's result";
+}
+
+TEST(EventDispatchTable, UnboundType) {
+  Handlers handlers;
+  Trundle::MousePressEvent event(0);
+  EXPECT_FALSE(table.dispatch(handlers, event))
+    << "Dispatch should fail when no handler is bound";
+  EXPECT_FALSE(event.handled);
+  EXPECT_EQ(-1, handlers.lastKey);
+  EXPECT_EQ(0, handlers.moves);
+}
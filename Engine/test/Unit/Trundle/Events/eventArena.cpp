@@ -0,0 +1,73 @@
+//===-- eventArena.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Events/eventArena.h>
+#include <Trundle/Events/keyEvent.h>
+#include <Trundle/Events/mouseEvent.h>
+#include <Trundle/Events/windowEvent.h>
+
+TEST(EventArena, DefaultConstructor) {
+  Trundle::EventArena arena;
+  EXPECT_EQ(0u, arena.size())
+    << "Arena should be empty when initalized";
+  EXPECT_EQ(Trundle::EventArena::blockSize, arena.capacity())
+    << "Arena should start with a single block";
+}
+
+TEST(EventArena, Create) {
+  Trundle::EventArena arena;
+  auto* press = arena.create<Trundle::KeyPressEvent>(65, false);
+  auto* move = arena.create<Trundle::MouseMoveEvent>(1.0, 2.0);
+  EXPECT_EQ(2u, arena.size())
+    << "Arena should contain exactly 2 events";
+  EXPECT_EQ(65, press->getKeyCode());
+  EXPECT_EQ(Trundle::EventType::MouseMove, move->getEventType());
+  EXPECT_EQ(0u,
+            reinterpret_cast<uintptr_t>(move) % alignof(Trundle::MouseMoveEvent))
+    << "Event was not correctly aligned";
+}
+
+TEST(EventArena, Reset) {
+  Trundle::EventArena arena;
+  auto* first = arena.create<Trundle::WindowCloseEvent>();
+  arena.reset();
+  EXPECT_EQ(0u, arena.size())
+    << "Arena should contain no events after a reset";
+  auto* second = arena.create<Trundle::WindowCloseEvent>();
+  EXPECT_EQ(static_cast<void*>(first), static_cast<void*>(second))
+    << "Memory was not reused after a reset";
+}
+
+TEST(EventArena, NoGrowthAfterWarmup) {
+  Trundle::EventArena arena;
+  for (int i = 0; i < 1000; ++i) {
+    arena.create<Trundle::MouseMoveEvent>(i, i);
+  }
+  size_t capacity = arena.capacity();
+  EXPECT_LT(Trundle::EventArena::blockSize, capacity)
+    << "Arena should have grown past a single block";
+
+  for (int frame = 0; frame < 10; ++frame) {
+    arena.reset();
+    for (int i = 0; i < 1000; ++i) {
+      arena.create<Trundle::MouseMoveEvent>(i, i);
+    }
+  }
+  EXPECT_EQ(capacity, arena.capacity())
+    << "Arena grew even though the frames were the same size";
+}
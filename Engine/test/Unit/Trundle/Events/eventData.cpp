@@ -0,0 +1,81 @@
+//===-- eventData.cpp -----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Events/eventData.h>
+
+TEST(EventData, EventType) {
+  EXPECT_EQ(Trundle::EventType::None,
+            Trundle::getEventType(Trundle::EventData{}));
+  EXPECT_EQ(Trundle::EventType::KeyPress,
+            Trundle::getEventType(Trundle::KeyPressData{65, false}));
+  EXPECT_EQ(Trundle::EventType::MouseMove,
+            Trundle::getEventType(Trundle::MouseMoveData{1.0, 2.0}));
+  EXPECT_EQ(Trundle::EventType::WindowResize,
+            Trundle::getEventType(Trundle::WindowResizeData{10, 20}));
+}
+
+TEST(EventData, FromEvent) {
+  Trundle::KeyPressEvent press(65, true);
+  auto data = Trundle::toEventData(press);
+  ASSERT_TRUE(std::holds_alternative<Trundle::KeyPressData>(data))
+    << "KeyPressEvent was converted to the wrong type";
+  EXPECT_EQ(65, std::get<Trundle::KeyPressData>(data).keyCode);
+  EXPECT_TRUE(std::get<Trundle::KeyPressData>(data).repeatEvent);
+
+  Trundle::WindowResizeEvent resize(10, 20);
+  data = Trundle::toEventData(resize);
+  ASSERT_TRUE(std::holds_alternative<Trundle::WindowResizeData>(data))
+    << "WindowResizeEvent was converted to the wrong type";
+  EXPECT_EQ(10, std::get<Trundle::WindowResizeData>(data).width);
+  EXPECT_EQ(20, std::get<Trundle::WindowResizeData>(data).height);
+}
+
+TEST(EventData, WithEvent) {
+  Trundle::EventData data = Trundle::MouseMoveData{3.0, 4.0};
+  bool called = false;
+  bool handled = Trundle::withEvent(data, [&](Trundle::Event& event) {
+    called = true;
+    ASSERT_EQ(Trundle::EventType::MouseMove, event.getEventType());
+    auto [x, y] = static_cast<Trundle::MouseMoveEvent&>(event).getPosition();
+    EXPECT_DOUBLE_EQ(3.0, x);
+    EXPECT_DOUBLE_EQ(4.0, y);
+    event.handled = true;
+  });
+  EXPECT_TRUE(called) << "Adapter did not call the function";
+  EXPECT_TRUE(handled) << "Handled flag was not returned";
+}
+
+TEST(EventData, ContiguousStorage) {
+  std::vector<Trundle::EventData> events;
+  events.push_back(Trundle::KeyPressData{65, false});
+  events.push_back(Trundle::MouseMoveData{1.0, 1.0});
+  events.push_back(Trundle::KeyReleaseData{65});
+  events.push_back(Trundle::WindowCloseData{});
+
+  int keys = 0;
+  for (const auto& event : events) {
+    std::visit([&](const auto& value) {
+      using T = std::decay_t<decltype(value)>;
+      if constexpr (std::is_same_v<T, Trundle::KeyPressData> ||
+                    std::is_same_v<T, Trundle::KeyReleaseData>) {
+        ++keys;
+      }
+    }, event);
+  }
+  EXPECT_EQ(2, keys) << "Visiting the events found the wrong key count";
+}
@@ -0,0 +1,93 @@
+//===-- eventLog.cpp ------------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Events/eventLog.h>
+
+#include <cstdio>
+
+TEST(EventLog, RecordRoundTrip) {
+  Trundle::EventData event = Trundle::MouseMoveData{1.5, 2.5, -1.0, 3.0};
+  auto record = Trundle::toEventRecord(event, 100, 7);
+  EXPECT_EQ(100u, record.timestamp);
+  EXPECT_EQ(7u, record.frame);
+  EXPECT_EQ(static_cast<uint32_t>(Trundle::EventType::MouseMove), record.type);
+
+  auto data = Trundle::toEventData(record);
+  ASSERT_TRUE(std::holds_alternative<Trundle::MouseMoveData>(data));
+  auto move = std::get<Trundle::MouseMoveData>(data);
+  EXPECT_EQ(1.5, move.x);
+  EXPECT_EQ(2.5, move.y);
+  EXPECT_EQ(-1.0, move.dx);
+  EXPECT_EQ(3.0, move.dy);
+}
+
+TEST(EventLog, UpdateRecord) {
+  auto record = Trundle::toUpdateRecord(16666667, 100, 7);
+  EXPECT_EQ(Trundle::UpdateRecordType, record.type);
+  EXPECT_EQ(7u, record.frame);
+  EXPECT_EQ(16666667u, Trundle::getUpdateStep(record));
+  EXPECT_EQ(Trundle::EventType::None,
+            Trundle::getEventType(Trundle::toEventData(record)))
+    << "Update records should not be read as events";
+}
+
+TEST(EventLog, UnknownRecordType) {
+  Trundle::EventRecord record{};
+  record.type = 1000;
+  EXPECT_EQ(Trundle::EventType::None,
+            Trundle::getEventType(Trundle::toEventData(record)))
+    << "Unknown records should be read as empty events";
+}
+
+TEST(EventLog, WriteAndRead) {
+  std::string path = testing::TempDir() + "eventLog_write_and_read.log";
+  Trundle::EventRecorder recorder;
+  ASSERT_TRUE(recorder.open(path));
+  recorder.record(Trundle::KeyPressData{65, true},
+                  Trundle::getTimestamp(), 0);
+  recorder.record(Trundle::UserData{3, 42}, Trundle::getTimestamp(), 1);
+  EXPECT_EQ(2u, recorder.size());
+  recorder.close();
+
+  Trundle::EventLog log(path);
+  ASSERT_TRUE(log.isValid());
+  ASSERT_EQ(2u, log.size());
+  EXPECT_EQ(0u, log[0].frame);
+  EXPECT_EQ(1u, log[1].frame);
+  EXPECT_LE(log[0].timestamp, log[1].timestamp)
+    << "Timestamps should never go backwards";
+
+  auto key = std::get<Trundle::KeyPressData>(Trundle::toEventData(log[0]));
+  EXPECT_EQ(65, key.keyCode);
+  EXPECT_TRUE(key.repeatEvent);
+  auto user = std::get<Trundle::UserData>(Trundle::toEventData(log[1]));
+  EXPECT_EQ(3u, user.code);
+  EXPECT_EQ(42u, user.payload);
+  std::remove(path.c_str());
+}
+
+TEST(EventLog, InvalidFile) {
+  std::string path = testing::TempDir() + "eventLog_invalid_file.log";
+  std::ofstream(path) << "not an event log";
+  EXPECT_FALSE(Trundle::EventLog(path).isValid())
+    << "A file without the event log header should be rejected";
+  std::remove(path.c_str());
+
+  EXPECT_FALSE(Trundle::EventLog(path).isValid())
+    << "A missing file should be rejected";
+}
@@ -0,0 +1,183 @@
+//===-- eventQueue.cpp ----------------------------------------------------===//
+//
+// Copyright 2021 Zachary Selk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+#include <gtest/gtest.h>
+#include <Trundle/Events/eventQueue.h>
+#include <Trundle/Events/keyEvent.h>
+#include <Trundle/Events/mouseEvent.h>
+#include <Trundle/Events/windowEvent.h>
+
+TEST(EventQueue, DefaultConstructor) {
+  Trundle::EventQueue queue;
+  EXPECT_TRUE(queue.empty())
+    << "Queue should be empty when initalized";
+  EXPECT_EQ(queue.begin(), queue.end());
+}
+
+TEST(EventQueue, Ordering) {
+  Trundle::EventQueue queue;
+  queue.push<Trundle::KeyPressEvent>(65, false);
+  queue.push<Trundle::MouseMoveEvent>(1.0, 2.0);
+  queue.push<Trundle::KeyReleaseEvent>(65);
+  ASSERT_EQ(3u, queue.size())
+    << "Queue should contain exactly 3 events";
+
+  auto it = queue.begin();
+  EXPECT_EQ(Trundle::EventType::KeyPress, (*it++)->getEventType());
+  EXPECT_EQ(Trundle::EventType::MouseMove, (*it++)->getEventType());
+  EXPECT_EQ(Trundle::EventType::KeyRelease, (*it++)->getEventType());
+  EXPECT_EQ(queue.end(), it);
+}
+
+TEST(EventQueue, Clear) {
+  Trundle::EventQueue queue;
+  queue.push<Trundle::WindowCloseEvent>();
+  queue.push<Trundle::WindowResizeEvent>(1, 1);
+  queue.clear();
+  EXPECT_TRUE(queue.empty())
+    << "Queue should be empty after being cleared";
+}
+
+TEST(EventQueue, CoalescingDisabled) {
+  Trundle::EventQueue queue;
+  EXPECT_FALSE(queue.isCoalescing())
+    << "Coalescing should be disabled by default";
+  queue.push<Trundle::MouseMoveEvent>(1.0, 1.0);
+  queue.push<Trundle::MouseMoveEvent>(2.0, 2.0);
+  EXPECT_EQ(2u, queue.size())
+    << "Events were merged while coalescing was disabled";
+}
+
+TEST(EventQueue, CoalesceMouseMoves) {
+  Trundle::EventQueue queue;
+  queue.setCoalescing(true);
+  queue.push<Trundle::MouseMoveEvent>(1.0, 1.0, 1.0, 1.0);
+  queue.push<Trundle::MouseMoveEvent>(3.0, 2.0, 2.0, 1.0);
+  queue.push<Trundle::MouseMoveEvent>(6.0, 0.0, 3.0, -2.0);
+  ASSERT_EQ(1u, queue.size())
+    << "Mouse moves were not merged";
+
+  auto* move = static_cast<Trundle::MouseMoveEvent*>(*queue.begin());
+  auto [x, y] = move->getPosition();
+  auto [dx, dy] = move->getDelta();
+  EXPECT_DOUBLE_EQ(6.0, x) << "Position should be the latest sample";
+  EXPECT_DOUBLE_EQ(0.0, y) << "Position should be the latest sample";
+  EXPECT_DOUBLE_EQ(6.0, dx) << "Deltas were not accumulated";
+  EXPECT_DOUBLE_EQ(0.0, dy) << "Deltas were not accumulated";
+}
+
+TEST(EventQueue, CoalesceScrolls) {
+  Trundle::EventQueue queue;
+  queue.setCoalescing(true);
+  queue.push<Trundle::MouseScrollEvent>(0.0, 1.0);
+  queue.push<Trundle::MouseScrollEvent>(0.5, 1.0);
+  queue.push<Trundle::MouseMoveEvent>(1.0, 1.0);
+  queue.push<Trundle::MouseScrollEvent>(0.0, -1.0);
+  ASSERT_EQ(2u, queue.size())
+    << "Scrolls should merge across a mouse move";
+
+  auto* scroll = static_cast<Trundle::MouseScrollEvent*>(*queue.begin());
+  auto [x, y] = scroll->getOffset();
+  EXPECT_DOUBLE_EQ(0.5, x) << "Scrolls were not accumulated";
+  EXPECT_DOUBLE_EQ(1.0, y) << "Scrolls were not accumulated";
+}
+
+TEST(EventQueue, CoalesceResizes) {
+  Trundle::EventQueue queue;
+  queue.setCoalescing(true);
+  queue.push<Trundle::WindowResizeEvent>(10, 10);
+  queue.push<Trundle::WindowResizeEvent>(20, 30);
+  ASSERT_EQ(1u, queue.size())
+    << "Resizes were not merged";
+  auto* resize = static_cast<Trundle::WindowResizeEvent*>(*queue.begin());
+  auto [w, h] = resize->getSize();
+  EXPECT_EQ(20, w);
+  EXPECT_EQ(30, h);
+}
+
+TEST(EventQueue, CoalescingPreservesOrder) {
+  Trundle::EventQueue queue;
+  queue.setCoalescing(true);
+  queue.push<Trundle::MouseMoveEvent>(1.0, 1.0);
+  queue.push<Trundle::MouseMoveEvent>(2.0, 2.0);
+  queue.push<Trundle::MousePressEvent>(0);
+  queue.push<Trundle::MouseMoveEvent>(3.0, 3.0);
+  queue.push<Trundle::MouseMoveEvent>(4.0, 4.0);
+  queue.push<Trundle::WindowResizeEvent>(1, 1);
+  queue.push<Trundle::MouseMoveEvent>(5.0, 5.0);
+  ASSERT_EQ(4u, queue.size())
+    << "Only events between two button events should be merged";
+
+  std::vector<Trundle::EventType> expected = {
+    Trundle::EventType::MouseMove, Trundle::EventType::MousePress,
+    Trundle::EventType::MouseMove, Trundle::EventType::WindowResize};
+  size_t i = 0;
+  for (auto* event : queue) {
+    EXPECT_EQ(expected[i++], event->getEventType());
+  }
+
+  auto* before = static_cast<Trundle::MouseMoveEvent*>(*queue.begin());
+  EXPECT_DOUBLE_EQ(2.0, std::get<0>(before->getPosition()))
+    << "Moves before the button press should not see later positions";
+  auto* move = static_cast<Trundle::MouseMoveEvent*>(*(queue.begin() + 2));
+  EXPECT_DOUBLE_EQ(5.0, std::get<0>(move->getPosition()))
+    << "Move after the button press should hold the latest position";
+}
+
+TEST(EventQueue, CoalesceInterleaved) {
+  // Dragging a window edge sends moves and resizes in turn.
+  Trundle::EventQueue queue;
+  queue.setCoalescing(true);
+  for (int i = 1; i <= 4; ++i) {
+    queue.push<Trundle::MouseMoveEvent>(i, i);
+    queue.push<Trundle::WindowResizeEvent>(10 * i, 10 * i);
+  }
+  ASSERT_EQ(2u, queue.size()) << "Interleaved events were not merged";
+
+  auto* move = static_cast<Trundle::MouseMoveEvent*>(*queue.begin());
+  EXPECT_DOUBLE_EQ(4.0, std::get<0>(move->getPosition()));
+  auto* resize =
+      static_cast<Trundle::WindowResizeEvent*>(*(queue.begin() + 1));
+  EXPECT_EQ(40, std::get<0>(resize->getSize()));
+}
+
+TEST(EventQueue, CoalescingAfterClear) {
+  Trundle::EventQueue queue;
+  queue.setCoalescing(true);
+  queue.push<Trundle::MouseMoveEvent>(1.0, 1.0);
+  queue.clear();
+  queue.push<Trundle::MouseMoveEvent>(2.0, 2.0);
+  EXPECT_EQ(1u, queue.size())
+    << "Queue should not merge into a cleared event";
+}
+
+TEST(EventQueue, Timestamps) {
+  Trundle::EventQueue queue;
+  queue.setCoalescing(true);
+  Trundle::Timestamp before = Trundle::getTimestamp();
+  auto* first = queue.push<Trundle::MouseMoveEvent>(1.0, 1.0);
+  Trundle::Timestamp stamped = first->timestamp;
+  auto* merged = queue.push<Trundle::MouseMoveEvent>(2.0, 2.0);
+  auto* key = queue.push<Trundle::KeyPressEvent>(65, false);
+
+  EXPECT_LE(before, stamped)
+    << "Queued events should be stamped with the current time";
+  EXPECT_EQ(stamped, merged->timestamp)
+    << "Coalesced events should keep the time of the oldest event";
+  EXPECT_LE(stamped, key->timestamp)
+    << "Timestamps should never go backwards";
+}